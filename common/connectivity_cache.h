@@ -0,0 +1,295 @@
+#pragma once
+
+// Standard C++ includes
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// POSIX includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//----------------------------------------------------------------------------
+// ConnectivityKey
+//----------------------------------------------------------------------------
+//! 64-bit FNV-1a hash of everything connectivity is built from - model name, parameters and
+//! a version which must be bumped whenever the code which builds connectivity changes
+class ConnectivityKey
+{
+public:
+    ConnectivityKey() : m_Hash(14695981039346656037ull)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Add raw bytes of a trivially-copyable value
+    template<typename T>
+    ConnectivityKey &add(const T &value)
+    {
+        addBytes(&value, sizeof(T));
+        return *this;
+    }
+
+    ConnectivityKey &add(const std::string &value)
+    {
+        addBytes(value.c_str(), value.size() + 1);
+        return *this;
+    }
+
+    ConnectivityKey &add(const char *value)
+    {
+        addBytes(value, strlen(value) + 1);
+        return *this;
+    }
+
+    uint64_t getHash() const{ return m_Hash; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void addBytes(const void *data, size_t numBytes)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data);
+        for(size_t i = 0; i < numBytes; i++) {
+            m_Hash ^= bytes[i];
+            m_Hash *= 1099511628211ull;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    uint64_t m_Hash;
+};
+
+//----------------------------------------------------------------------------
+// ConnectivityCacheHeader
+//----------------------------------------------------------------------------
+//! Header at the start of connectivity cache files. It is followed by numArrays
+//! ConnectivityCacheEntry structures and then the array data itself
+struct ConnectivityCacheHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numArrays;
+    uint64_t key;
+
+    static constexpr const char *magicString = "CONNCACH";
+    static constexpr uint32_t currentVersion = 1;
+};
+
+//----------------------------------------------------------------------------
+// ConnectivityCacheEntry
+//----------------------------------------------------------------------------
+//! Location of a named array within a connectivity cache file
+struct ConnectivityCacheEntry
+{
+    char name[48];
+    uint64_t offset;
+    uint64_t numBytes;
+};
+
+//----------------------------------------------------------------------------
+// ConnectivityCacheWriter
+//----------------------------------------------------------------------------
+//! Gathers named arrays and writes them to a connectivity cache file
+/*! Arrays are only referenced so they must remain valid until write() is called */
+class ConnectivityCacheWriter
+{
+public:
+    ConnectivityCacheWriter(const std::string &filename, uint64_t key) : m_Filename(filename), m_Key(key)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    template<typename T>
+    void addArray(const std::string &name, const T *data, size_t count)
+    {
+        if(name.size() >= sizeof(ConnectivityCacheEntry::name)) {
+            throw std::runtime_error("Connectivity cache array name '" + name + "' is too long");
+        }
+        m_Arrays.push_back({name, data, sizeof(T) * count});
+    }
+
+    //! Write cache - data is written to a temporary file which is then renamed over
+    //! filename so concurrent readers never see a partially-written cache
+    void write() const
+    {
+        const std::string tempFilename = m_Filename + ".tmp";
+        {
+            std::ofstream stream(tempFilename, std::ios::binary);
+            if(!stream.good()) {
+                throw std::runtime_error("Cannot open connectivity cache '" + tempFilename + "' for writing");
+            }
+
+            ConnectivityCacheHeader header;
+            memcpy(header.magic, ConnectivityCacheHeader::magicString, sizeof(header.magic));
+            header.version = ConnectivityCacheHeader::currentVersion;
+            header.numArrays = (uint32_t)m_Arrays.size();
+            header.key = m_Key;
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(ConnectivityCacheHeader));
+
+            // Build table of contents with each array aligned to a cache line
+            uint64_t offset = getAligned(sizeof(ConnectivityCacheHeader) + (sizeof(ConnectivityCacheEntry) * m_Arrays.size()));
+            for(const auto &a : m_Arrays) {
+                ConnectivityCacheEntry entry;
+                memset(&entry, 0, sizeof(ConnectivityCacheEntry));
+                strncpy(entry.name, a.name.c_str(), sizeof(entry.name) - 1);
+                entry.offset = offset;
+                entry.numBytes = a.numBytes;
+                stream.write(reinterpret_cast<const char*>(&entry), sizeof(ConnectivityCacheEntry));
+
+                offset = getAligned(offset + a.numBytes);
+            }
+
+            // Write arrays, padding each one to alignment
+            const char padding[alignment] = {};
+            for(const auto &a : m_Arrays) {
+                stream.write(padding, getAligned((uint64_t)stream.tellp()) - (uint64_t)stream.tellp());
+                stream.write(reinterpret_cast<const char*>(a.data), a.numBytes);
+            }
+
+            if(!stream.good()) {
+                throw std::runtime_error("Error writing connectivity cache '" + tempFilename + "'");
+            }
+        }
+
+        if(std::rename(tempFilename.c_str(), m_Filename.c_str()) != 0) {
+            throw std::runtime_error("Cannot rename connectivity cache '" + tempFilename + "' to '" + m_Filename + "'");
+        }
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Array
+    //----------------------------------------------------------------------------
+    struct Array
+    {
+        std::string name;
+        const void *data;
+        size_t numBytes;
+    };
+
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr uint64_t alignment = 64;
+
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    static uint64_t getAligned(uint64_t offset){ return ((offset + alignment - 1) / alignment) * alignment; }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const std::string m_Filename;
+    const uint64_t m_Key;
+    std::vector<Array> m_Arrays;
+};
+
+//----------------------------------------------------------------------------
+// ConnectivityCache
+//----------------------------------------------------------------------------
+//! Read-only, memory-mapped view of a connectivity cache file
+/*! A missing cache or one built with a different key or file format version is not an error -
+    isValid() just returns false so the caller can build connectivity and write a new cache.
+    Arrays are used directly from the mapping so the OS only pages in connectivity which is used. */
+class ConnectivityCache
+{
+public:
+    ConnectivityCache(const std::string &filename, uint64_t key) : m_Filename(filename), m_Data(nullptr), m_Size(0)
+    {
+        // If file can't be opened, leave cache invalid
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if(fd == -1) {
+            return;
+        }
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == -1 || (size_t)fileStat.st_size < sizeof(ConnectivityCacheHeader)) {
+            close(fd);
+            return;
+        }
+        m_Size = (size_t)fileStat.st_size;
+
+        // Map file - the mapping remains valid after the file descriptor is closed
+        m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(m_Data == MAP_FAILED) {
+            m_Data = nullptr;
+            throw std::runtime_error("Cannot memory map connectivity cache '" + filename + "'");
+        }
+
+        // If cache is stale, unmap it
+        const ConnectivityCacheHeader *header = getHeader();
+        if(memcmp(header->magic, ConnectivityCacheHeader::magicString, sizeof(header->magic)) != 0
+            || header->version != ConnectivityCacheHeader::currentVersion || header->key != key
+            || m_Size < sizeof(ConnectivityCacheHeader) + (sizeof(ConnectivityCacheEntry) * header->numArrays))
+        {
+            munmap(m_Data, m_Size);
+            m_Data = nullptr;
+        }
+    }
+
+    ~ConnectivityCache()
+    {
+        if(m_Data != nullptr) {
+            munmap(m_Data, m_Size);
+        }
+    }
+
+    ConnectivityCache(const ConnectivityCache&) = delete;
+    ConnectivityCache &operator=(const ConnectivityCache&) = delete;
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    bool isValid() const{ return (m_Data != nullptr); }
+
+    //! Get pointer to named array which must contain count elements
+    template<typename T>
+    const T *getArray(const std::string &name, size_t count) const
+    {
+        const ConnectivityCacheHeader *header = getHeader();
+        const ConnectivityCacheEntry *entries = reinterpret_cast<const ConnectivityCacheEntry*>(header + 1);
+        for(uint32_t a = 0; a < header->numArrays; a++) {
+            if(strncmp(entries[a].name, name.c_str(), sizeof(entries[a].name)) == 0) {
+                if(entries[a].numBytes != (sizeof(T) * count)) {
+                    throw std::runtime_error("Array '" + name + "' in connectivity cache '" + m_Filename + "' has unexpected size");
+                }
+                // **NOTE** compare against space after offset so corrupt entries can't overflow
+                if(entries[a].offset > m_Size || entries[a].numBytes > (m_Size - entries[a].offset)) {
+                    throw std::runtime_error("Connectivity cache '" + m_Filename + "' is truncated");
+                }
+                return reinterpret_cast<const T*>(reinterpret_cast<const char*>(m_Data) + entries[a].offset);
+            }
+        }
+        throw std::runtime_error("Array '" + name + "' not found in connectivity cache '" + m_Filename + "'");
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    const ConnectivityCacheHeader *getHeader() const{ return reinterpret_cast<const ConnectivityCacheHeader*>(m_Data); }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const std::string m_Filename;
+    void *m_Data;
+    size_t m_Size;
+};
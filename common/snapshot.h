@@ -0,0 +1,161 @@
+#pragma once
+
+// Standard C++ includes
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+// Snapshot
+//----------------------------------------------------------------------------
+//! Captures model state into a compact binary blob which can be restored, saved to or loaded from disk.
+/*! Each piece of state (typically a GeNN state variable array or a struct of simulation state)
+    is registered once with addVariable. capture() then concatenates all of the registered memory
+    into a single buffer and restore() copies it back so, for small models, both are a handful of
+    memcpys. Many variants of an experiment can therefore be forked from one warmed-up state.
+    Files consist of an 8 byte "SNAPSHOT" magic, a uint32 region count and the size of each region
+    as a uint64 (used to check the file was saved from the same model) followed by the blob. */
+class Snapshot
+{
+public:
+    Snapshot() : m_Size(0)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Register count elements of state starting at data
+    template<typename T>
+    void addVariable(T *data, size_t count = 1)
+    {
+        m_Regions.push_back({reinterpret_cast<char*>(data), sizeof(T) * count});
+        m_Size += sizeof(T) * count;
+    }
+
+    //! Copy current state of all registered variables into snapshot
+    void capture()
+    {
+        m_Data.resize(m_Size);
+        char *out = m_Data.data();
+        for(const auto &r : m_Regions) {
+            memcpy(out, r.data, r.size);
+            out += r.size;
+        }
+    }
+
+    //! Copy state from snapshot back into all registered variables
+    void restore() const
+    {
+        if(m_Data.size() != m_Size) {
+            throw std::runtime_error("Snapshot has not been captured");
+        }
+
+        const char *in = m_Data.data();
+        for(const auto &r : m_Regions) {
+            memcpy(r.data, in, r.size);
+            in += r.size;
+        }
+    }
+
+    //! Write captured snapshot to disk
+    void save(const std::string &filename) const
+    {
+        if(m_Data.size() != m_Size) {
+            throw std::runtime_error("Snapshot has not been captured");
+        }
+
+        std::ofstream stream(filename, std::ios::binary);
+        if(!stream.good()) {
+            throw std::runtime_error("Cannot open snapshot '" + filename + "' for writing");
+        }
+
+        // Write header describing layout
+        const uint32_t numRegions = (uint32_t)m_Regions.size();
+        stream.write(getMagic(), magicLength);
+        stream.write(reinterpret_cast<const char*>(&numRegions), sizeof(uint32_t));
+        for(const auto &r : m_Regions) {
+            const uint64_t size = r.size;
+            stream.write(reinterpret_cast<const char*>(&size), sizeof(uint64_t));
+        }
+
+        // Write blob
+        stream.write(m_Data.data(), m_Data.size());
+        if(!stream.good()) {
+            throw std::runtime_error("Error writing snapshot '" + filename + "'");
+        }
+    }
+
+    //! Read snapshot from disk - call restore() to apply it
+    void load(const std::string &filename)
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        if(!stream.good()) {
+            throw std::runtime_error("Cannot open snapshot '" + filename + "'");
+        }
+
+        // Check header matches registered layout
+        char fileMagic[magicLength];
+        uint32_t numRegions = 0;
+        stream.read(fileMagic, sizeof(fileMagic));
+        stream.read(reinterpret_cast<char*>(&numRegions), sizeof(uint32_t));
+        if(!stream.good() || memcmp(fileMagic, getMagic(), magicLength) != 0 || numRegions != m_Regions.size()) {
+            throw std::runtime_error("'" + filename + "' is not a snapshot of this model");
+        }
+        for(const auto &r : m_Regions) {
+            uint64_t size = 0;
+            stream.read(reinterpret_cast<char*>(&size), sizeof(uint64_t));
+            if(size != r.size) {
+                throw std::runtime_error("'" + filename + "' is not a snapshot of this model");
+            }
+        }
+
+        // Read blob into temporary buffer so a failed load can't leave partial state to be restored
+        std::vector<char> data(m_Size);
+        stream.read(data.data(), data.size());
+        if(!stream.good()) {
+            throw std::runtime_error("Snapshot '" + filename + "' is truncated");
+        }
+
+        // Check blob is exactly the size of the registered state
+        if(stream.peek() != std::char_traits<char>::eof()) {
+            throw std::runtime_error("'" + filename + "' is not a snapshot of this model");
+        }
+        m_Data.swap(data);
+    }
+
+    size_t getSize() const{ return m_Size; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Region
+    //----------------------------------------------------------------------------
+    struct Region
+    {
+        char *data;
+        size_t size;
+    };
+
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr size_t magicLength = 8;
+
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    //! **NOTE** a function rather than a static constexpr member so it never needs an out-of-line definition
+    static const char *getMagic(){ return "SNAPSHOT"; }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    std::vector<Region> m_Regions;
+    size_t m_Size;
+    std::vector<char> m_Data;
+};
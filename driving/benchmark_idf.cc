@@ -0,0 +1,105 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// Driving includes
+#include "route_memory.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+// Snapshot dimensions used in drive.ipynb
+const unsigned int width = 450;
+const unsigned int height = 50;
+
+//! Reference implementation of drive.ipynb's calc_idf
+double calcReferenceDifference(const uint8_t *a, const uint8_t *b, size_t numPixels)
+{
+    double sum = 0.0;
+    for(size_t i = 0; i < numPixels; i++) {
+        const double diff = (double)a[i] - (double)b[i];
+        sum += diff * diff;
+    }
+    return std::sqrt(sum);
+}
+
+//! Reference implementation of difference between snapshot and image rotated left by rotation columns
+double calcReferenceRotatedDifference(const uint8_t *image, const uint8_t *snapshot, unsigned int rotation)
+{
+    double sum = 0.0;
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            const double diff = (double)image[(y * width) + ((x + rotation) % width)] - (double)snapshot[(y * width) + x];
+            sum += diff * diff;
+        }
+    }
+    return std::sqrt(sum);
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int numSnapshots = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    const unsigned int numThreads = (argc > 2) ? std::atoi(argv[2]) : 0;
+
+    // Generate random route
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<unsigned int> pixelDist(0, 255);
+    std::vector<uint8_t> route(numSnapshots * width * height);
+    for(auto &p : route) {
+        p = (uint8_t)pixelDist(gen);
+    }
+
+    RouteMemory memory(width, height, numThreads);
+    memory.addSnapshots(route.data(), numSnapshots);
+
+    // Compare whole route against itself
+    std::vector<double> differences(numSnapshots * numSnapshots);
+    const auto start = std::chrono::high_resolution_clock::now();
+    memory.calcIDF(route.data(), numSnapshots, differences.data());
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    const double numComparisons = (double)numSnapshots * (double)numSnapshots;
+    std::cout << numSnapshots << "x" << numSnapshots << " comparisons using " << memory.getNumThreads() << " threads: "
+        << duration.count() << "s, " << numComparisons / duration.count() << " comparisons/s, "
+        << (numComparisons * memory.getNumPixels()) / (duration.count() * 1.0E9) << " GPixel/s" << std::endl;
+
+    // Check a row against reference
+    const unsigned int checkRow = numSnapshots / 2;
+    for(unsigned int s = 0; s < numSnapshots; s++) {
+        const double reference = calcReferenceDifference(memory.getSnapshot(checkRow), memory.getSnapshot(s), memory.getNumPixels());
+        if(differences[(checkRow * numSnapshots) + s] != reference) {
+            std::cerr << "Difference between " << checkRow << " and " << s << " doesn't match reference" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Calculate rotational IDF of one image against whole route
+    std::vector<double> rotatedDifferences(numSnapshots * width);
+    const auto ridfStart = std::chrono::high_resolution_clock::now();
+    memory.calcRIDF(memory.getSnapshot(checkRow), rotatedDifferences.data());
+    const std::chrono::duration<double> ridfDuration = std::chrono::high_resolution_clock::now() - ridfStart;
+    std::cout << "Rotational IDF against " << numSnapshots << " snapshots: " << ridfDuration.count() << "s, "
+        << (numSnapshots * width) / ridfDuration.count() << " rotated comparisons/s" << std::endl;
+
+    // Check rotations of a snapshot against reference
+    const unsigned int checkSnapshot = numSnapshots / 3;
+    for(unsigned int r = 0; r < width; r++) {
+        const double reference = calcReferenceRotatedDifference(memory.getSnapshot(checkRow), memory.getSnapshot(checkSnapshot), r);
+        if(rotatedDifferences[(checkSnapshot * width) + r] != reference) {
+            std::cerr << "Rotational difference between " << checkRow << " and " << checkSnapshot << " at rotation "
+                << r << " doesn't match reference" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdlib>
+
+// Driving includes
+#include "vp_tree.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+// Spherical harmonic coefficients used by load_spherical i.e. degree 5 without DC
+const unsigned int numDimensions = 35;
+
+const unsigned int numQueries = 1000;
+
+// Standard deviation of route's step between snapshots and of query noise
+const double stepSD = 0.05;
+const double querySD = 0.2;
+
+const double errorBounds[] = {0.0, 0.1, 0.25, 0.5, 1.0};
+
+//! Generate route as smooth random walk through descriptor space - like real
+//! routes, consecutive snapshots are similar so descriptors lie close to a curve
+std::vector<double> generateRoute(unsigned int numSnapshots, std::mt19937 &gen)
+{
+    std::normal_distribution<double> stepDist(0.0, stepSD);
+    std::vector<double> route(numSnapshots * numDimensions);
+    std::vector<double> velocity(numDimensions, 0.0);
+    for(unsigned int s = 1; s < numSnapshots; s++) {
+        for(unsigned int d = 0; d < numDimensions; d++) {
+            velocity[d] = (0.9 * velocity[d]) + stepDist(gen);
+            route[(s * numDimensions) + d] = route[((s - 1) * numDimensions) + d] + velocity[d];
+        }
+    }
+    return route;
+}
+
+//! Exhaustively find k nearest snapshots to each query
+void bruteForce(const std::vector<double> &route, const std::vector<double> &queries, unsigned int k,
+                std::vector<size_t> &indices)
+{
+    const size_t numSnapshots = route.size() / numDimensions;
+    std::vector<std::pair<double, size_t>> distances(numSnapshots);
+    for(unsigned int q = 0; q < numQueries; q++) {
+        for(size_t s = 0; s < numSnapshots; s++) {
+            double sum = 0.0;
+            for(unsigned int d = 0; d < numDimensions; d++) {
+                const double diff = queries[(q * numDimensions) + d] - route[(s * numDimensions) + d];
+                sum += diff * diff;
+            }
+            distances[s] = std::make_pair(std::sqrt(sum), s);
+        }
+        std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+        for(unsigned int i = 0; i < k; i++) {
+            indices[(q * k) + i] = distances[i].second;
+        }
+    }
+}
+
+//! Fraction of true k nearest neighbours returned
+double calcRecall(const std::vector<size_t> &indices, const std::vector<size_t> &trueIndices, unsigned int k)
+{
+    size_t numFound = 0;
+    for(unsigned int q = 0; q < numQueries; q++) {
+        const auto begin = trueIndices.cbegin() + (q * k);
+        for(unsigned int i = 0; i < k; i++) {
+            if(std::find(begin, begin + k, indices[(q * k) + i]) != (begin + k)) {
+                numFound++;
+            }
+        }
+    }
+    return (double)numFound / (double)(numQueries * k);
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int numSnapshots = (argc > 1) ? std::atoi(argv[1]) : 100000;
+    const unsigned int k = (argc > 2) ? std::atoi(argv[2]) : 1;
+    const unsigned int numThreads = (argc > 3) ? std::atoi(argv[3]) : 0;
+    if(numSnapshots == 0 || k == 0 || k > numSnapshots) {
+        std::cerr << "Usage: benchmark_index [<number of snapshots> [<k> [<number of threads>]]]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Generate route and queries near random points along it, as if from a second traversal
+    std::mt19937 gen(1234);
+    const std::vector<double> route = generateRoute(numSnapshots, gen);
+    std::uniform_int_distribution<unsigned int> snapshotDist(0, numSnapshots - 1);
+    std::normal_distribution<double> queryDist(0.0, querySD);
+    std::vector<double> queries(numQueries * numDimensions);
+    for(unsigned int q = 0; q < numQueries; q++) {
+        const unsigned int s = snapshotDist(gen);
+        for(unsigned int d = 0; d < numDimensions; d++) {
+            queries[(q * numDimensions) + d] = route[(s * numDimensions) + d] + queryDist(gen);
+        }
+    }
+
+    const auto buildStart = std::chrono::high_resolution_clock::now();
+    VPTree tree(route.data(), numSnapshots, numDimensions, 16, numThreads);
+    const std::chrono::duration<double> buildDuration = std::chrono::high_resolution_clock::now() - buildStart;
+    std::cout << "Built tree over " << numSnapshots << " " << numDimensions << "-dimensional descriptors in "
+        << buildDuration.count() << "s" << std::endl;
+
+    // **NOTE** brute force is single-threaded so it is compared against single-threaded queries below
+    std::vector<size_t> trueIndices(numQueries * k);
+    const auto bruteStart = std::chrono::high_resolution_clock::now();
+    bruteForce(route, queries, k, trueIndices);
+    const std::chrono::duration<double, std::micro> bruteDuration = std::chrono::high_resolution_clock::now() - bruteStart;
+    const double bruteQueryTime = bruteDuration.count() / (double)numQueries;
+    std::cout << "Brute force " << k << "-NN: " << bruteQueryTime << "us/query" << std::endl;
+
+    std::cout << "Error bound, Query time [us], Speedup, Distances calculated [%], Recall" << std::endl;
+    VPTree singleThreadTree(route.data(), numSnapshots, numDimensions, 16, 1);
+    std::vector<size_t> indices(numQueries * k);
+    std::vector<double> distances(numQueries * k);
+    for(double errorBound : errorBounds) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        const size_t numDistances = singleThreadTree.query(queries.data(), numQueries, k, errorBound, indices.data(), distances.data());
+        const std::chrono::duration<double, std::micro> duration = std::chrono::high_resolution_clock::now() - start;
+        const double queryTime = duration.count() / (double)numQueries;
+
+        const double recall = calcRecall(indices, trueIndices, k);
+        std::cout << errorBound << ", " << queryTime << ", " << bruteQueryTime / queryTime << ", "
+            << (100.0 * (double)numDistances) / ((double)numQueries * (double)numSnapshots) << ", " << recall << std::endl;
+
+        if(errorBound == 0.0 && recall != 1.0) {
+            std::cerr << "Exact query doesn't match brute force" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Throughput using all threads
+    const auto start = std::chrono::high_resolution_clock::now();
+    tree.query(queries.data(), numQueries, k, 0.0, indices.data(), distances.data());
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+    std::cout << "Exact queries using all threads: " << numQueries / duration.count() << " queries/s" << std::endl;
+    return EXIT_SUCCESS;
+}
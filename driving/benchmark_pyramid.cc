@@ -0,0 +1,153 @@
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// Driving includes
+#include "pyramid_route_memory.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+// Snapshot dimensions used in drive.ipynb
+const unsigned int width = 450;
+const unsigned int height = 50;
+
+const unsigned int numQueries = 200;
+
+// Number of sinusoidal components making up each synthetic panorama
+const unsigned int numComponents = 8;
+
+// Standard deviation of pixel noise added to snapshots and queries
+const double pixelNoiseSD = 2.0;
+
+//! Generate route of smooth panoramas whose components drift slowly along it, like a real route where
+//! consecutive snapshots are similar. Queries are taken from a second, noisier traversal of the same route.
+void generateRoute(unsigned int numSnapshots, std::mt19937 &gen, std::vector<uint8_t> &route, std::vector<uint8_t> &queries)
+{
+    std::normal_distribution<double> driftDist(0.0, 0.02);
+    std::normal_distribution<double> noiseDist(0.0, pixelNoiseSD);
+    std::uniform_real_distribution<double> phaseDist(0.0, 6.283185307179586);
+    std::uniform_int_distribution<unsigned int> snapshotDist(0, numSnapshots - 1);
+
+    // Each component has a horizontal frequency, vertical profile, amplitude and phase which drifts
+    std::vector<double> amplitudes(numComponents, 15.0);
+    std::vector<double> phases(numComponents);
+    std::generate(phases.begin(), phases.end(), [&gen, &phaseDist](){ return phaseDist(gen); });
+
+    std::vector<double> clean(numSnapshots * width * height);
+    for(unsigned int s = 0; s < numSnapshots; s++) {
+        for(unsigned int c = 0; c < numComponents; c++) {
+            phases[c] += driftDist(gen);
+            amplitudes[c] = std::max(0.0, amplitudes[c] + (10.0 * driftDist(gen)));
+        }
+
+        for(unsigned int y = 0; y < height; y++) {
+            for(unsigned int x = 0; x < width; x++) {
+                double value = 128.0;
+                for(unsigned int c = 0; c < numComponents; c++) {
+                    const double frequency = (double)(c + 1) * 6.283185307179586 / (double)width;
+                    value += amplitudes[c] * std::sin((frequency * x) + phases[c]) * std::cos((double)(c * y) / (double)height);
+                }
+                clean[(((size_t)s * height) + y) * width + x] = value;
+            }
+        }
+    }
+
+    auto addNoise =
+        [&gen, &noiseDist](double value)
+        {
+            return (uint8_t)std::min(255.0, std::max(0.0, std::round(value + noiseDist(gen))));
+        };
+    route.resize(clean.size());
+    std::transform(clean.cbegin(), clean.cend(), route.begin(), addNoise);
+
+    const size_t numPixels = width * height;
+    queries.resize(numQueries * numPixels);
+    for(unsigned int q = 0; q < numQueries; q++) {
+        const auto snapshot = clean.cbegin() + (snapshotDist(gen) * numPixels);
+        std::transform(snapshot, snapshot + numPixels, &queries[q * numPixels], addNoise);
+    }
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int numSnapshots = (argc > 1) ? std::atoi(argv[1]) : 5000;
+    const unsigned int k = (argc > 2) ? std::atoi(argv[2]) : 1;
+    const unsigned int numThreads = (argc > 3) ? std::atoi(argv[3]) : 1;
+    if(numSnapshots == 0 || k == 0) {
+        std::cerr << "Usage: benchmark_pyramid [<number of snapshots> [<k> [<number of threads>]]]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 gen(1234);
+    std::vector<uint8_t> route;
+    std::vector<uint8_t> queries;
+    generateRoute(numSnapshots, gen, route, queries);
+
+    const auto buildStart = std::chrono::high_resolution_clock::now();
+    PyramidRouteMemory memory(width, height, numThreads);
+    memory.addSnapshots(route.data(), numSnapshots);
+    const std::chrono::duration<double> buildDuration = std::chrono::high_resolution_clock::now() - buildStart;
+    std::cout << "Added " << numSnapshots << " snapshots with pyramid levels of block size";
+    for(unsigned int b : memory.getBlockSizes()) {
+        std::cout << " " << b;
+    }
+    std::cout << " in " << buildDuration.count() << "s" << std::endl;
+
+    // Exhaustive search - calculate full IDF of each frame in turn, as during navigation, and sort by difference and then index
+    std::vector<double> idf(numQueries * numSnapshots);
+    std::vector<size_t> exhaustiveIndices(numQueries * k);
+    const auto exhaustiveStart = std::chrono::high_resolution_clock::now();
+    std::vector<size_t> order(numSnapshots);
+    for(unsigned int q = 0; q < numQueries; q++) {
+        double *differences = &idf[q * numSnapshots];
+        memory.getRouteMemory().calcIDF(&queries[q * width * height], differences);
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + std::min(k, numSnapshots), order.end(),
+                          [differences](size_t a, size_t b){ return (differences[a] < differences[b]) || (differences[a] == differences[b] && a < b); });
+        for(unsigned int i = 0; i < k; i++) {
+            exhaustiveIndices[(q * k) + i] = (i < numSnapshots) ? order[i] : numSnapshots;
+        }
+    }
+    const std::chrono::duration<double, std::micro> exhaustiveDuration = std::chrono::high_resolution_clock::now() - exhaustiveStart;
+    const double exhaustiveQueryTime = exhaustiveDuration.count() / (double)numQueries;
+
+    // Coarse-to-fine search of each frame in turn
+    std::vector<size_t> indices(numQueries * k);
+    std::vector<double> differences(numQueries * k);
+    size_t numComparisons = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int q = 0; q < numQueries; q++) {
+        numComparisons += memory.calcBestMatches(&queries[q * width * height], 1, k, &indices[q * k], &differences[q * k]);
+    }
+    const std::chrono::duration<double, std::micro> duration = std::chrono::high_resolution_clock::now() - start;
+    const double queryTime = duration.count() / (double)numQueries;
+
+    std::cout << "Exhaustive: " << exhaustiveQueryTime << "us/frame" << std::endl;
+    std::cout << "Coarse-to-fine: " << queryTime << "us/frame, " << exhaustiveQueryTime / queryTime << "x faster, "
+        << (100.0 * (double)numComparisons) / ((double)numQueries * (double)numSnapshots) << "% of snapshots compared at full resolution" << std::endl;
+
+    // Check results are identical
+    for(unsigned int q = 0; q < numQueries; q++) {
+        for(unsigned int i = 0; i < k; i++) {
+            const size_t s = exhaustiveIndices[(q * k) + i];
+            if(indices[(q * k) + i] != s || (s < numSnapshots && differences[(q * k) + i] != idf[(q * numSnapshots) + s])) {
+                std::cerr << "Coarse-to-fine match " << i << " of query " << q << " doesn't match exhaustive search" << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return EXIT_SUCCESS;
+}
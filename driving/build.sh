@@ -0,0 +1,6 @@
+#!/bin/bash
+# Native route memory library used by route_memory.py
+g++ route_memory_c.cc -std=c++11 -O3 -march=native -pthread -shared -fPIC -o libroute_memory.so
+g++ benchmark_idf.cc -std=c++11 -O3 -march=native -pthread -o benchmark_idf
+g++ benchmark_index.cc -std=c++11 -O3 -march=native -pthread -o benchmark_index
+g++ benchmark_pyramid.cc -std=c++11 -O3 -march=native -pthread -o benchmark_pyramid
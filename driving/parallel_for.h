@@ -0,0 +1,39 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cstddef>
+
+//----------------------------------------------------------------------------
+// Free functions
+//----------------------------------------------------------------------------
+//! Number of threads to use if numThreads is zero i.e. 'automatic'
+inline unsigned int getDefaultNumThreads(unsigned int numThreads)
+{
+    return (numThreads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : numThreads;
+}
+
+//! Split range [0, n) into at most numThreads contiguous chunks and call f(begin, end) on each from its own thread
+template<typename F>
+void parallelFor(size_t n, unsigned int numThreads, F f)
+{
+    const size_t numChunks = std::min<size_t>(numThreads, n);
+    if(numChunks <= 1) {
+        f(0, n);
+        return;
+    }
+
+    // The calling thread processes the first chunk
+    std::vector<std::thread> threads;
+    for(size_t t = 1; t < numChunks; t++) {
+        threads.emplace_back(f, (n * t) / numChunks, (n * (t + 1)) / numChunks);
+    }
+    f(0, n / numChunks);
+    for(auto &t : threads) {
+        t.join();
+    }
+}
@@ -0,0 +1,293 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+
+// Driving includes
+#include "parallel_for.h"
+#include "route_memory.h"
+
+//----------------------------------------------------------------------------
+// PyramidRouteMemory
+//----------------------------------------------------------------------------
+//! RouteMemory which also stores an image pyramid of block sums for each snapshot to find best matches coarse-to-fine
+/*! By Cauchy-Schwarz, the squared difference between the sums of a block of n pixels in two images is at
+    most n times the sum of squared differences (SSD) of those pixels. So, summed over any tiling of blocks,
+    block sum differences give a lower bound on the full-resolution SSD which costs a fraction of the pixels
+    to calculate. Queries visit snapshots in order of their bound at the coarsest level and, once the k best
+    full-resolution matches found so far are closer than a snapshot's bound at any level, it can be skipped
+    without calculating its full SSD. Every comparison is exact integer arithmetic and ties are broken by
+    snapshot index so results are identical to sorting the exhaustive IDF. */
+class PyramidRouteMemory
+{
+public:
+    //! Block sizes must divide width and height - by default, they are chosen by getDefaultBlockSizes
+    PyramidRouteMemory(unsigned int width, unsigned int height, unsigned int numThreads = 0,
+                       const std::vector<unsigned int> &blockSizes = {})
+    :   m_Memory(width, height, numThreads)
+    {
+        for(unsigned int b : (blockSizes.empty() ? getDefaultBlockSizes(width, height) : blockSizes)) {
+            if(b == 0 || b > maxBlockSize || (width % b) != 0 || (height % b) != 0) {
+                throw std::runtime_error("Block size " + std::to_string(b) + " is too large or doesn't tile "
+                                         + std::to_string(width) + "x" + std::to_string(height) + " images");
+            }
+            const size_t numBlocks = (size_t)(width / b) * (height / b);
+            const size_t stride = ((numBlocks + boundChunkBlocks - 1) / boundChunkBlocks) * boundChunkBlocks;
+            m_Levels.push_back(Level{b, width / b, height / b, stride, {}});
+        }
+
+        // Coarsest level first
+        std::sort(m_Levels.begin(), m_Levels.end(),
+                  [](const Level &a, const Level &b){ return a.blockSize > b.blockSize; });
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Add snapshot of getNumPixels() row-major pixels
+    void addSnapshot(const uint8_t *image)
+    {
+        addSnapshots(image, 1);
+    }
+
+    //! Add numSnapshots snapshots stored contiguously, building their pyramids
+    void addSnapshots(const uint8_t *images, size_t numSnapshots)
+    {
+        m_Memory.addSnapshots(images, numSnapshots);
+        for(auto &level : m_Levels) {
+            const size_t first = level.sums.size() / level.stride;
+            level.sums.resize(level.sums.size() + (numSnapshots * level.stride));
+            parallelFor(numSnapshots, m_Memory.getNumThreads(),
+                        [this, images, first, &level](size_t begin, size_t end)
+                        {
+                            for(size_t s = begin; s < end; s++) {
+                                calcBlockSums(level, &images[s * getNumPixels()], &level.sums[(first + s) * level.stride]);
+                            }
+                        });
+        }
+    }
+
+    //! Find the k snapshots most similar to each of numImages contiguous images, writing numImages x k row-major
+    //! matrices of snapshot indices and differences, best first. Results are identical to sorting calcIDF by
+    //! difference and then index. If k exceeds the number of snapshots, surplus indices are set to getNumSnapshots()
+    //! and differences to infinity. Returns the total number of full-resolution comparisons made.
+    size_t calcBestMatches(const uint8_t *images, size_t numImages, unsigned int k,
+                           size_t *indices, double *differences) const
+    {
+        std::vector<size_t> numComparisons(numImages);
+        parallelFor(numImages, m_Memory.getNumThreads(),
+                    [this, images, k, indices, differences, &numComparisons](size_t begin, size_t end)
+                    {
+                        std::vector<std::pair<uint64_t, size_t>> best;
+                        for(size_t i = begin; i < end; i++) {
+                            numComparisons[i] = calcBestMatches(&images[i * getNumPixels()], k, best);
+                            for(unsigned int j = 0; j < k; j++) {
+                                const bool valid = (j < best.size());
+                                indices[(i * k) + j] = valid ? best[j].second : getNumSnapshots();
+                                differences[(i * k) + j] = valid ? std::sqrt((double)best[j].first) : std::numeric_limits<double>::infinity();
+                            }
+                        }
+                    });
+        return std::accumulate(numComparisons.cbegin(), numComparisons.cend(), size_t{0});
+    }
+
+    size_t getNumPixels() const{ return m_Memory.getNumPixels(); }
+    size_t getNumSnapshots() const{ return m_Memory.getNumSnapshots(); }
+
+    //! Block sizes of pyramid levels, coarsest first
+    std::vector<unsigned int> getBlockSizes() const
+    {
+        std::vector<unsigned int> blockSizes;
+        std::transform(m_Levels.cbegin(), m_Levels.cend(), std::back_inserter(blockSizes),
+                       [](const Level &l){ return l.blockSize; });
+        return blockSizes;
+    }
+
+    //! Underlying full-resolution snapshots - snapshots should only be added through the PyramidRouteMemory
+    const RouteMemory &getRouteMemory() const{ return m_Memory; }
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    //! Common divisors of width and height up to maxBlockSize with at least minLevelBlocks blocks, thinned so
+    //! each level has at least 4x fewer blocks than the next finer one e.g. 10, 5 and 2 for 450x50
+    static std::vector<unsigned int> getDefaultBlockSizes(unsigned int width, unsigned int height)
+    {
+        std::vector<unsigned int> blockSizes;
+        // **NOTE** maxBlockSize is copied as std::min takes references and it has no out-of-line definition
+        for(unsigned int b = std::min(std::min(width, height), (unsigned int)maxBlockSize); b >= 2; b--) {
+            if((width % b) == 0 && (height % b) == 0 && ((width / b) * (height / b)) >= minLevelBlocks
+               && (blockSizes.empty() || (blockSizes.back() * blockSizes.back()) >= (4 * b * b)))
+            {
+                blockSizes.push_back(b);
+            }
+        }
+        return blockSizes;
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Level
+    //----------------------------------------------------------------------------
+    struct Level
+    {
+        unsigned int blockSize;
+        unsigned int width;
+        unsigned int height;
+
+        //! Number of blocks padded with zeros to a multiple of boundChunkBlocks
+        size_t stride;
+
+        //! Padded block sums of each snapshot, stored contiguously
+        std::vector<uint16_t> sums;
+    };
+
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    //! Coarser levels bound the SSD too loosely to prune anything
+    static constexpr unsigned int minLevelBlocks = 64;
+
+    //! Largest block whose sums fit in 16 bits - the squared difference between two such sums then fits in 32
+    static constexpr unsigned int maxBlockSize = 16;
+
+    //! Blocks compared at a time when calculating bounds - level sums are padded to a multiple of this so there are no scalar tails
+    static constexpr unsigned int boundChunkBlocks = 64;
+
+    //! Rows of pixels compared at a time at full resolution before checking whether the SSD can still match
+    static constexpr unsigned int verifyChunkRows = 10;
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void calcBlockSums(const Level &level, const uint8_t *image, uint16_t *sums) const
+    {
+        std::fill_n(sums, level.stride, 0);
+        const unsigned int imageWidth = m_Memory.getWidth();
+        for(unsigned int y = 0; y < m_Memory.getHeight(); y++) {
+            uint16_t *rowSums = &sums[(y / level.blockSize) * level.width];
+            for(unsigned int x = 0; x < imageWidth; x++) {
+                rowSums[x / level.blockSize] += image[(y * imageWidth) + x];
+            }
+        }
+    }
+
+    //! Block size squared times lower bound on full-resolution SSD between block sums a and b,
+    //! abandoned after the first chunk of blocks where it exceeds limit
+    static uint64_t calcScaledLowerBound(const Level &level, const uint16_t *a, const uint16_t *b,
+                                         uint64_t limit = std::numeric_limits<uint64_t>::max())
+    {
+        uint64_t bound = 0;
+        for(size_t i = 0; i < level.stride && bound <= limit; i += boundChunkBlocks) {
+            for(size_t j = i; j < (i + boundChunkBlocks); j++) {
+                const int32_t diff = (int32_t)a[j] - (int32_t)b[j];
+                bound += (uint32_t)diff * (uint32_t)diff;
+            }
+        }
+        return bound;
+    }
+
+    //! Full-resolution SSD between image and snapshot, abandoned after the first chunk of rows where it exceeds limit
+    uint64_t calcSSD(const uint8_t *image, const uint8_t *snapshot, uint64_t limit) const
+    {
+        uint64_t ssd = 0;
+        const size_t chunkPixels = (size_t)verifyChunkRows * m_Memory.getWidth();
+        for(size_t i = 0; i < getNumPixels() && ssd <= limit; i += chunkPixels) {
+            ssd += RouteMemory::calcSSD(&image[i], &snapshot[i], std::min(chunkPixels, getNumPixels() - i));
+        }
+        return ssd;
+    }
+
+    //! Find k best (SSD, snapshot) pairs for image, sorted, returning number of full-resolution comparisons made
+    size_t calcBestMatches(const uint8_t *image, unsigned int k, std::vector<std::pair<uint64_t, size_t>> &best) const
+    {
+        best.clear();
+        const size_t numSnapshots = getNumSnapshots();
+        if(k == 0 || numSnapshots == 0) {
+            return 0;
+        }
+
+        // Build query's pyramid
+        std::vector<std::vector<uint16_t>> querySums(m_Levels.size());
+        for(size_t l = 0; l < m_Levels.size(); l++) {
+            querySums[l].resize(m_Levels[l].stride);
+            calcBlockSums(m_Levels[l], image, querySums[l].data());
+        }
+
+        // Order snapshots by bound at coarsest level so good matches are found early
+        // **NOTE** without levels, every snapshot has the same zero bound
+        std::vector<std::pair<uint64_t, size_t>> candidates(numSnapshots);
+        for(size_t s = 0; s < numSnapshots; s++) {
+            candidates[s].first = m_Levels.empty() ? 0 : calcScaledLowerBound(m_Levels[0], querySums[0].data(),
+                                                                               getSums(m_Levels[0], s));
+            candidates[s].second = s;
+        }
+        // **NOTE** usually only a few candidates are visited so, rather than sorting them all, they are popped from a min-heap
+        const auto greater = std::greater<std::pair<uint64_t, size_t>>();
+        std::make_heap(candidates.begin(), candidates.end(), greater);
+
+        // Maintain max-heap of k best (SSD, snapshot) pairs - ties are broken by index
+        size_t numComparisons = 0;
+        for(auto end = candidates.end(); end != candidates.begin(); --end) {
+            std::pop_heap(candidates.begin(), end, greater);
+            const auto &c = *(end - 1);
+
+            // Skip snapshot if, at any level, its bound exceeds the current k-th best SSD
+            // **NOTE** as candidates are sorted by coarsest bound, failing at the coarsest level ends the search
+            const uint64_t worst = (best.size() == k) ? best.front().first : std::numeric_limits<uint64_t>::max();
+            if(best.size() == k && !m_Levels.empty()) {
+                if(c.first > (worst * getBlockArea(0))) {
+                    break;
+                }
+
+                bool pruned = false;
+                for(size_t l = 1; l < m_Levels.size() && !pruned; l++) {
+                    const uint64_t limit = worst * getBlockArea(l);
+                    pruned = (calcScaledLowerBound(m_Levels[l], querySums[l].data(), getSums(m_Levels[l], c.second), limit) > limit);
+                }
+                if(pruned) {
+                    continue;
+                }
+            }
+
+            // Calculate full-resolution SSD and offer it as a match - if the SSD is
+            // abandoned, it's already worse than the k-th best so won't be added
+            const std::pair<uint64_t, size_t> match(calcSSD(image, m_Memory.getSnapshot(c.second), worst), c.second);
+            numComparisons++;
+            if(best.size() < k) {
+                best.push_back(match);
+                std::push_heap(best.begin(), best.end());
+            }
+            else if(match < best.front()) {
+                std::pop_heap(best.begin(), best.end());
+                best.back() = match;
+                std::push_heap(best.begin(), best.end());
+            }
+        }
+        std::sort_heap(best.begin(), best.end());
+        return numComparisons;
+    }
+
+    const uint16_t *getSums(const Level &level, size_t snapshot) const{ return &level.sums[snapshot * level.stride]; }
+    uint64_t getBlockArea(size_t level) const{ return (uint64_t)m_Levels[level].blockSize * m_Levels[level].blockSize; }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    RouteMemory m_Memory;
+
+    //! Pyramid levels, coarsest first
+    std::vector<Level> m_Levels;
+};
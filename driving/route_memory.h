@@ -0,0 +1,255 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// SIMD includes
+#if defined(__AVX2__) || defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+// Driving includes
+#include "parallel_for.h"
+
+//----------------------------------------------------------------------------
+// RouteMemory
+//----------------------------------------------------------------------------
+//! Stores a route's greyscale snapshots in one contiguous uint8 array and compares images against them
+/*! The image difference function (IDF) between a query and each snapshot is the square root of the
+    sum of squared pixel differences, as calculated by calc_idf in drive.ipynb. Differences are summed
+    exactly in integers so results are identical to numpy's float64 calculation. */
+class RouteMemory
+{
+public:
+    RouteMemory(unsigned int width, unsigned int height, unsigned int numThreads = 0)
+    :   m_Width(width), m_Height(height), m_NumPixels(width * height),
+        m_NumThreads(getDefaultNumThreads(numThreads))
+    {
+        if(width == 0 || height == 0) {
+            throw std::runtime_error("Cannot create RouteMemory for empty images");
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Add snapshot of getNumPixels() row-major pixels
+    void addSnapshot(const uint8_t *image)
+    {
+        m_Snapshots.insert(m_Snapshots.end(), image, image + m_NumPixels);
+    }
+
+    //! Add numSnapshots snapshots stored contiguously
+    void addSnapshots(const uint8_t *images, size_t numSnapshots)
+    {
+        m_Snapshots.insert(m_Snapshots.end(), images, images + (numSnapshots * m_NumPixels));
+    }
+
+    //! Calculate difference between image and every snapshot, writing getNumSnapshots() differences
+    void calcIDF(const uint8_t *image, double *differences) const
+    {
+        calcIDF(image, 1, differences);
+    }
+
+    //! Calculate differences between numImages contiguous images and every snapshot,
+    //! writing a numImages x getNumSnapshots() row-major matrix of differences
+    void calcIDF(const uint8_t *images, size_t numImages, double *differences) const
+    {
+        // If there are enough images, split them between threads, otherwise split the snapshots
+        if(numImages >= m_NumThreads) {
+            parallelFor(numImages, m_NumThreads,
+                        [this, images, differences](size_t begin, size_t end)
+                        {
+                            calcIDFBlock(images, begin, end, 0, getNumSnapshots(), differences);
+                        });
+        }
+        else {
+            parallelFor(getNumSnapshots(), m_NumThreads,
+                        [this, images, numImages, differences](size_t begin, size_t end)
+                        {
+                            calcIDFBlock(images, 0, numImages, begin, end, differences);
+                        });
+        }
+    }
+
+    //! Calculate rotational image difference function between image and every snapshot, writing a
+    //! getNumSnapshots() x getWidth() row-major matrix. Element (s, r) is the difference between snapshot s
+    //! and image rotated left by r columns i.e. np.roll(image, -r, axis=1) so it has turned r * 360 / width degrees
+    void calcRIDF(const uint8_t *image, double *differences) const
+    {
+        const std::vector<uint8_t> doubled = getDoubledImage(image);
+        parallelFor(getNumSnapshots(), m_NumThreads,
+                    [this, &doubled, differences](size_t begin, size_t end)
+                    {
+                        std::vector<uint64_t> ssds(m_Width);
+                        for(size_t s = begin; s < end; s++) {
+                            calcRotationSSDs(doubled.data(), getSnapshot(s), ssds.data());
+                            std::transform(ssds.cbegin(), ssds.cend(), &differences[s * m_Width],
+                                           [](uint64_t ssd){ return std::sqrt((double)ssd); });
+                        }
+                    });
+    }
+
+    //! Find the rotation of image which best matches each snapshot, writing getNumSnapshots()
+    //! rotations (in columns, as in calcRIDF) and the differences at these rotations
+    void calcBestRotations(const uint8_t *image, unsigned int *bestRotations, double *minDifferences) const
+    {
+        const std::vector<uint8_t> doubled = getDoubledImage(image);
+        parallelFor(getNumSnapshots(), m_NumThreads,
+                    [this, &doubled, bestRotations, minDifferences](size_t begin, size_t end)
+                    {
+                        std::vector<uint64_t> ssds(m_Width);
+                        for(size_t s = begin; s < end; s++) {
+                            calcRotationSSDs(doubled.data(), getSnapshot(s), ssds.data());
+                            const auto best = std::min_element(ssds.cbegin(), ssds.cend());
+                            bestRotations[s] = (unsigned int)std::distance(ssds.cbegin(), best);
+                            minDifferences[s] = std::sqrt((double)*best);
+                        }
+                    });
+    }
+
+    unsigned int getWidth() const{ return m_Width; }
+    unsigned int getHeight() const{ return m_Height; }
+    size_t getNumPixels() const{ return m_NumPixels; }
+    size_t getNumSnapshots() const{ return m_Snapshots.size() / m_NumPixels; }
+    unsigned int getNumThreads() const{ return m_NumThreads; }
+
+    const uint8_t *getSnapshot(size_t i) const{ return &m_Snapshots[i * m_NumPixels]; }
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    //! Sum of squared differences between numPixels pixels of a and b
+    static uint64_t calcSSD(const uint8_t *a, const uint8_t *b, size_t numPixels)
+    {
+        uint64_t ssd = 0;
+        size_t i = 0;
+
+        // **NOTE** each 32-bit lane can hold 33025 maximal squared differences so
+        // SIMD accumulators are flushed into the 64-bit total every block
+#if defined(__AVX2__)
+        const __m256i zero = _mm256_setzero_si256();
+        while((i + 32) <= numPixels) {
+            __m256i blockSSD = _mm256_setzero_si256();
+            const size_t blockEnd = std::min(numPixels, i + ssdBlockPixels);
+            for(; (i + 32) <= blockEnd; i += 32) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&a[i]));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&b[i]));
+
+                // Widen to 16-bit, subtract and square and add adjacent pairs into 32-bit lanes
+                const __m256i diffLow = _mm256_sub_epi16(_mm256_unpacklo_epi8(va, zero), _mm256_unpacklo_epi8(vb, zero));
+                const __m256i diffHigh = _mm256_sub_epi16(_mm256_unpackhi_epi8(va, zero), _mm256_unpackhi_epi8(vb, zero));
+                blockSSD = _mm256_add_epi32(blockSSD, _mm256_madd_epi16(diffLow, diffLow));
+                blockSSD = _mm256_add_epi32(blockSSD, _mm256_madd_epi16(diffHigh, diffHigh));
+            }
+
+            uint32_t lanes[8];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), blockSSD);
+            for(uint32_t l : lanes) {
+                ssd += l;
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        while((i + 16) <= numPixels) {
+            __m128i blockSSD = _mm_setzero_si128();
+            const size_t blockEnd = std::min(numPixels, i + ssdBlockPixels);
+            for(; (i + 16) <= blockEnd; i += 16) {
+                const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i]));
+                const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[i]));
+
+                // Widen to 16-bit, subtract and square and add adjacent pairs into 32-bit lanes
+                const __m128i diffLow = _mm_sub_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero));
+                const __m128i diffHigh = _mm_sub_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero));
+                blockSSD = _mm_add_epi32(blockSSD, _mm_madd_epi16(diffLow, diffLow));
+                blockSSD = _mm_add_epi32(blockSSD, _mm_madd_epi16(diffHigh, diffHigh));
+            }
+
+            uint32_t lanes[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), blockSSD);
+            for(uint32_t l : lanes) {
+                ssd += l;
+            }
+        }
+#endif
+
+        // Handle remaining pixels
+        for(; i < numPixels; i++) {
+            const int diff = (int)a[i] - (int)b[i];
+            ssd += (uint64_t)(diff * diff);
+        }
+        return ssd;
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    //! Pixels summed into SIMD accumulators before they are flushed - keeps 32-bit lanes from overflowing
+    static constexpr size_t ssdBlockPixels = 32768;
+
+    //! Snapshots compared against each image in turn so a block stays in cache across images
+    static constexpr size_t snapshotBlockSize = 16;
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void calcIDFBlock(const uint8_t *images, size_t imageBegin, size_t imageEnd,
+                      size_t snapshotBegin, size_t snapshotEnd, double *differences) const
+    {
+        const size_t numSnapshots = getNumSnapshots();
+        for(size_t s = snapshotBegin; s < snapshotEnd; s += snapshotBlockSize) {
+            const size_t blockEnd = std::min(snapshotEnd, s + snapshotBlockSize);
+            for(size_t i = imageBegin; i < imageEnd; i++) {
+                const uint8_t *image = &images[i * m_NumPixels];
+                for(size_t b = s; b < blockEnd; b++) {
+                    differences[(i * numSnapshots) + b] = std::sqrt((double)calcSSD(image, getSnapshot(b), m_NumPixels));
+                }
+            }
+        }
+    }
+
+    //! Copy image with each row repeated twice so every rotation of a row is a contiguous range
+    std::vector<uint8_t> getDoubledImage(const uint8_t *image) const
+    {
+        std::vector<uint8_t> doubled(m_NumPixels * 2);
+        for(unsigned int y = 0; y < m_Height; y++) {
+            const uint8_t *row = &image[y * m_Width];
+            std::copy(row, row + m_Width, &doubled[y * 2 * m_Width]);
+            std::copy(row, row + m_Width, &doubled[((y * 2) + 1) * m_Width]);
+        }
+        return doubled;
+    }
+
+    //! Calculate sum of squared differences between snapshot and every rotation of the doubled image
+    void calcRotationSSDs(const uint8_t *doubled, const uint8_t *snapshot, uint64_t *ssds) const
+    {
+        // **NOTE** doubled image and snapshot together are small enough to remain in L2 cache
+        for(unsigned int r = 0; r < m_Width; r++) {
+            uint64_t ssd = 0;
+            for(unsigned int y = 0; y < m_Height; y++) {
+                ssd += calcSSD(&doubled[(y * 2 * m_Width) + r], &snapshot[y * m_Width], m_Width);
+            }
+            ssds[r] = ssd;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_Width;
+    const unsigned int m_Height;
+    const size_t m_NumPixels;
+    const unsigned int m_NumThreads;
+
+    //! Snapshots stored contiguously, row-major
+    std::vector<uint8_t> m_Snapshots;
+};
@@ -0,0 +1,315 @@
+import ctypes
+import os
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import cv2
+import numpy as np
+from glob import glob
+
+# Load native library built by build.sh from the same directory as this module
+_lib = ctypes.CDLL(os.path.join(os.path.dirname(os.path.abspath(__file__)), "libroute_memory.so"))
+
+_lib.route_memory_get_last_error.restype = ctypes.c_char_p
+_lib.route_memory_get_last_error.argtypes = []
+_lib.route_memory_create.restype = ctypes.c_void_p
+_lib.route_memory_create.argtypes = [ctypes.c_uint, ctypes.c_uint, ctypes.c_uint]
+_lib.route_memory_destroy.restype = None
+_lib.route_memory_destroy.argtypes = [ctypes.c_void_p]
+_lib.route_memory_add_snapshots.restype = ctypes.c_int
+_lib.route_memory_add_snapshots.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t]
+_lib.route_memory_get_num_snapshots.restype = ctypes.c_size_t
+_lib.route_memory_get_num_snapshots.argtypes = [ctypes.c_void_p]
+_lib.route_memory_calc_idf.restype = ctypes.c_int
+_lib.route_memory_calc_idf.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t, ctypes.c_void_p]
+_lib.route_memory_calc_ridf.restype = ctypes.c_int
+_lib.route_memory_calc_ridf.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+_lib.route_memory_calc_best_rotations.restype = ctypes.c_int
+_lib.route_memory_calc_best_rotations.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+_lib.pyramid_route_memory_create.restype = ctypes.c_void_p
+_lib.pyramid_route_memory_create.argtypes = [ctypes.c_uint, ctypes.c_uint, ctypes.c_uint]
+_lib.pyramid_route_memory_destroy.restype = None
+_lib.pyramid_route_memory_destroy.argtypes = [ctypes.c_void_p]
+_lib.pyramid_route_memory_get_route_memory.restype = ctypes.c_void_p
+_lib.pyramid_route_memory_get_route_memory.argtypes = [ctypes.c_void_p]
+_lib.pyramid_route_memory_add_snapshots.restype = ctypes.c_int
+_lib.pyramid_route_memory_add_snapshots.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t]
+_lib.pyramid_route_memory_calc_best_matches.restype = ctypes.c_int
+_lib.pyramid_route_memory_calc_best_matches.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint,
+                                                        ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+_lib.spherical_harmonics_create.restype = ctypes.c_void_p
+_lib.spherical_harmonics_create.argtypes = [ctypes.c_uint, ctypes.c_uint, ctypes.c_uint, ctypes.c_double, ctypes.c_uint]
+_lib.spherical_harmonics_destroy.restype = None
+_lib.spherical_harmonics_destroy.argtypes = [ctypes.c_void_p]
+_lib.spherical_harmonics_get_num_coefficients.restype = ctypes.c_uint
+_lib.spherical_harmonics_get_num_coefficients.argtypes = [ctypes.c_void_p]
+_lib.spherical_harmonics_extract.restype = ctypes.c_int
+_lib.spherical_harmonics_extract.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t, ctypes.c_void_p]
+_lib.vp_tree_create.restype = ctypes.c_void_p
+_lib.vp_tree_create.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint, ctypes.c_uint, ctypes.c_uint]
+_lib.vp_tree_destroy.restype = None
+_lib.vp_tree_destroy.argtypes = [ctypes.c_void_p]
+_lib.vp_tree_query.restype = ctypes.c_int
+_lib.vp_tree_query.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint, ctypes.c_double,
+                               ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p]
+
+def _check(result):
+    if result != 0:
+        raise RuntimeError(_lib.route_memory_get_last_error().decode())
+
+def _check_handle(handle):
+    # Create functions return a null pointer on failure
+    if not handle:
+        raise RuntimeError(_lib.route_memory_get_last_error().decode())
+    return handle
+
+def _get_route_filenames(path):
+    # Use glob to find images in path and then sort by INTEGER number
+    wildcard = path + "/image_*.png"
+    return sorted(glob(wildcard), key=lambda f: int(f[len(path) + 7:len(f) - 4]))
+
+def _read_route(filenames, num_threads=0):
+    # Read greyscale images directly into packed uint8 array - OpenCV releases the GIL while decoding so threads overlap
+    with ThreadPoolExecutor(max_workers=(num_threads or None)) as executor:
+        images = list(executor.map(lambda f: cv2.imread(f, cv2.IMREAD_GRAYSCALE), filenames))
+    return np.stack(images)
+
+def _pack(images):
+    # Convert (height, width, n) array, as returned by load_route, into contiguous uint8 snapshots
+    return np.ascontiguousarray(np.moveaxis(images, 2, 0), dtype=np.uint8)
+
+# **NOTE** the native library trusts the sizes of the buffers it's passed so shapes are checked before calling it
+def _check_images(images, width, height):
+    if images.ndim != 3 or images.shape[:2] != (height, width):
+        raise ValueError("Expected (%u, %u, n) array of images but got %s" % (height, width, images.shape))
+
+def _pack_image(image, width, height):
+    # Convert (height, width) image into contiguous uint8 image
+    if image.shape != (height, width):
+        raise ValueError("Expected (%u, %u) image but got %s" % (height, width, image.shape))
+    return np.ascontiguousarray(image, dtype=np.uint8)
+
+class RouteMemory(object):
+    """Route snapshots packed into one contiguous uint8 array with a
+    multithreaded, SIMD image difference function implemented in C++"""
+    def __init__(self, images=None, width=450, height=50, num_threads=0):
+        if images is not None:
+            height, width = images.shape[:2]
+
+        self.width = width
+        self.height = height
+        self._handle = _check_handle(_lib.route_memory_create(width, height, num_threads))
+        if images is not None:
+            self.add_snapshots(images)
+
+    def __del__(self):
+        if getattr(self, "_handle", None):
+            _lib.route_memory_destroy(self._handle)
+
+    def __len__(self):
+        return _lib.route_memory_get_num_snapshots(self._handle)
+
+    def add_snapshots(self, images):
+        """Add (height, width, n) array of snapshots"""
+        _check_images(images, self.width, self.height)
+        self._add_packed(_pack(images))
+
+    def _add_packed(self, packed):
+        if packed.shape[1:] != (self.height, self.width):
+            raise ValueError("Expected (n, %u, %u) packed images but got %s" % (self.height, self.width, packed.shape))
+        _check(_lib.route_memory_add_snapshots(self._handle, packed.ctypes.data, packed.shape[0]))
+
+    def calc_idf(self, image):
+        """Difference between (height, width) image and every snapshot - equivalent to calc_idf"""
+        packed = _pack_image(image, self.width, self.height)
+        differences = np.empty(len(self))
+        _check(_lib.route_memory_calc_idf(self._handle, packed.ctypes.data, 1, differences.ctypes.data))
+        return differences
+
+    def calc_idf_matrix(self, images):
+        """Differences between each of a (height, width, n) array of images and every snapshot as an (n, len(self)) matrix"""
+        _check_images(images, self.width, self.height)
+        packed = _pack(images)
+        differences = np.empty((packed.shape[0], len(self)))
+        _check(_lib.route_memory_calc_idf(self._handle, packed.ctypes.data, packed.shape[0], differences.ctypes.data))
+        return differences
+
+    def calc_ridf(self, image):
+        """Rotational IDF between (height, width) image and every snapshot as a (len(self), width) matrix.
+        Element (s, r) is the difference between snapshot s and np.roll(image, -r, axis=1)"""
+        packed = _pack_image(image, self.width, self.height)
+        differences = np.empty((len(self), self.width))
+        _check(_lib.route_memory_calc_ridf(self._handle, packed.ctypes.data, differences.ctypes.data))
+        return differences
+
+    def calc_best_headings(self, image):
+        """Best matching heading (degrees) and minimum rotational difference for each snapshot"""
+        packed = _pack_image(image, self.width, self.height)
+        best_rotations = np.empty(len(self), dtype=np.uintc)
+        min_differences = np.empty(len(self))
+        _check(_lib.route_memory_calc_best_rotations(self._handle, packed.ctypes.data,
+                                                     best_rotations.ctypes.data, min_differences.ctypes.data))
+        return (best_rotations * 360.0) / self.width, min_differences
+
+class PyramidRouteMemory(RouteMemory):
+    """RouteMemory which also precomputes an image pyramid for each snapshot so the best matching snapshots
+    can be found coarse-to-fine, only comparing a few at full resolution. See pyramid_route_memory.h"""
+    def __init__(self, images=None, width=450, height=50, num_threads=0):
+        if images is not None:
+            height, width = images.shape[:2]
+
+        # **NOTE** RouteMemory methods use the full-resolution memory owned by the pyramid
+        self._pyramid = _check_handle(_lib.pyramid_route_memory_create(width, height, num_threads))
+        self._handle = _lib.pyramid_route_memory_get_route_memory(self._pyramid)
+        self.width = width
+        self.height = height
+
+        # Number of full-resolution comparisons made by last call to best_matches
+        self.num_comparisons = 0
+        if images is not None:
+            self.add_snapshots(images)
+
+    def __del__(self):
+        if getattr(self, "_pyramid", None):
+            _lib.pyramid_route_memory_destroy(self._pyramid)
+
+    def _add_packed(self, packed):
+        if packed.shape[1:] != (self.height, self.width):
+            raise ValueError("Expected (n, %u, %u) packed images but got %s" % (self.height, self.width, packed.shape))
+        _check(_lib.pyramid_route_memory_add_snapshots(self._pyramid, packed.ctypes.data, packed.shape[0]))
+
+    def best_matches(self, image, k=1):
+        """Indices of and differences to the k snapshots most similar to (height, width) image, best first -
+        identical to sorting calc_idf(image) by difference and then index"""
+        packed = _pack_image(image, self.width, self.height)
+        indices = np.empty(k, dtype=np.uintp)
+        differences = np.empty(k)
+        num_comparisons = ctypes.c_size_t()
+        _check(_lib.pyramid_route_memory_calc_best_matches(self._pyramid, packed.ctypes.data, 1, k, indices.ctypes.data,
+                                                           differences.ctypes.data, ctypes.byref(num_comparisons)))
+        self.num_comparisons = num_comparisons.value
+        return indices, differences
+
+def load_route_memory(path, pyramid=False):
+    """Load route into RouteMemory, or PyramidRouteMemory if pyramid is set - like
+    drive.ipynb's load_route, the first frame is discarded as it's always blank"""
+    packed = _read_route(_get_route_filenames(path)[1:])
+    memory = (PyramidRouteMemory if pyramid else RouteMemory)(width=packed.shape[2], height=packed.shape[1])
+    memory._add_packed(packed)
+    return memory
+
+def calc_idf(image, images):
+    """Drop-in replacement for drive.ipynb's calc_idf - images can be a RouteMemory or a (height, width, n) array"""
+    if not isinstance(images, RouteMemory):
+        images = RouteMemory(images)
+    return images.calc_idf(image)
+
+class SphericalHarmonicExtractor(object):
+    """Projects panoramic images onto real spherical harmonics up to max_degree using precomputed basis tables.
+    Coefficients are ordered by degree and then order, as in image2sphcoef's CSV output. By default, pixels
+    are assumed to be square with the image centred on the horizon - see spherical_harmonics.h"""
+    def __init__(self, width=450, height=50, max_degree=5, vertical_fov=0.0, num_threads=0):
+        self.width = width
+        self.height = height
+        self._handle = _check_handle(_lib.spherical_harmonics_create(width, height, max_degree, vertical_fov, num_threads))
+        self.num_coefficients = _lib.spherical_harmonics_get_num_coefficients(self._handle)
+
+    def __del__(self):
+        if getattr(self, "_handle", None):
+            _lib.spherical_harmonics_destroy(self._handle)
+
+    def extract(self, images):
+        """Coefficients of (height, width, n) array of images as a (num_coefficients, n) matrix"""
+        _check_images(images, self.width, self.height)
+        return self._extract_packed(_pack(images))
+
+    def _extract_packed(self, packed):
+        if packed.shape[1:] != (self.height, self.width):
+            raise ValueError("Expected (n, %u, %u) packed images but got %s" % (self.height, self.width, packed.shape))
+        coefficients = np.empty((packed.shape[0], self.num_coefficients))
+        _check(_lib.spherical_harmonics_extract(self._handle, packed.ctypes.data, packed.shape[0], coefficients.ctypes.data))
+        return coefficients.T
+
+def extract_spherical(path, filename="spherical.npy", max_degree=5, vertical_fov=0.0, num_threads=0):
+    """Native alternative to spherical.sh, used by spherical_native.sh - reads each of a route's images once, extracts
+    the spherical harmonic coefficients of all of them in parallel and saves them in path as a single (num_coefficients, n)
+    matrix. Coefficients depend on the projection assumed in spherical_harmonics.h so they aren't identical to image2sphcoef's"""
+    packed = _read_route(_get_route_filenames(path), num_threads)
+    extractor = SphericalHarmonicExtractor(packed.shape[2], packed.shape[1], max_degree, vertical_fov, num_threads)
+    coefficients = extractor._extract_packed(packed)
+    np.save(os.path.join(path, filename), coefficients)
+    return coefficients
+
+def load_spherical(path, filename="spherical.npy"):
+    """Equivalent of drive.ipynb's load_spherical for matrices saved by extract_spherical"""
+    data = np.load(os.path.join(path, filename))
+
+    # Return data, throwing away first frame cos it's always blank and first coefficient as it's DC
+    return data[1:,1:]
+
+def downsample_route(images, factor=5):
+    """Descriptors of (height, width, n) array of images downsampled by factor as a (num_pixels, n) matrix"""
+    return np.stack([cv2.resize(images[:,:,i].astype(np.float32), None, fx=1.0 / factor, fy=1.0 / factor,
+                                interpolation=cv2.INTER_AREA).flatten()
+                     for i in range(images.shape[2])], axis=1).astype(np.float64)
+
+class SnapshotIndex(object):
+    """Vantage-point tree over snapshot descriptors supporting k-nearest-neighbour queries without
+    comparing against every snapshot. Descriptors are columns of a (num_dimensions, n) matrix, as
+    returned by load_spherical or downsample_route. See vp_tree.h"""
+    def __init__(self, descriptors, leaf_size=16, num_threads=0):
+        packed = np.ascontiguousarray(descriptors.T, dtype=np.float64)
+        self.num_dimensions = packed.shape[1]
+        self._handle = _check_handle(_lib.vp_tree_create(packed.ctypes.data, packed.shape[0], self.num_dimensions,
+                                                         leaf_size, num_threads))
+        self.num_items = packed.shape[0]
+
+        # Number of distances calculated by last query
+        self.num_distances = 0
+
+    def __del__(self):
+        if getattr(self, "_handle", None):
+            _lib.vp_tree_destroy(self._handle)
+
+    def __len__(self):
+        return self.num_items
+
+    def query(self, queries, k=1, error_bound=0.0):
+        """Indices of and distances to k nearest snapshots, nearest first, for a (num_dimensions,) query or each
+        column of a (num_dimensions, m) matrix of queries. With error_bound = 0, results are exact, otherwise each
+        neighbour is within a factor of (1 + error_bound) of the true one"""
+        if queries.ndim not in (1, 2) or queries.shape[0] != self.num_dimensions:
+            raise ValueError("Expected (%u,) query or (%u, m) matrix of queries but got %s"
+                             % (self.num_dimensions, self.num_dimensions, queries.shape))
+        single = (queries.ndim == 1)
+        packed = np.ascontiguousarray(queries[np.newaxis,:] if single else queries.T, dtype=np.float64)
+        indices = np.empty((packed.shape[0], k), dtype=np.uintp)
+        distances = np.empty((packed.shape[0], k))
+        num_distances = ctypes.c_size_t()
+        _check(_lib.vp_tree_query(self._handle, packed.ctypes.data, packed.shape[0], k, error_bound,
+                                  indices.ctypes.data, distances.ctypes.data, ctypes.byref(num_distances)))
+        self.num_distances = num_distances.value
+        return (indices[0], distances[0]) if single else (indices, distances)
+
+def benchmark_snapshot_index(descriptors, queries, k=1, error_bounds=(0.0, 0.1, 0.25, 0.5, 1.0)):
+    """Print speed and recall of SnapshotIndex against numpy brute force for each column of queries"""
+    start = time.time()
+    index = SnapshotIndex(descriptors)
+    print("Built index over %u snapshots in %fs" % (len(index), time.time() - start))
+
+    start = time.time()
+    true_indices = np.empty((queries.shape[1], k), dtype=np.uintp)
+    for q in range(queries.shape[1]):
+        distances = np.sqrt(np.sum((descriptors - queries[:,q:q + 1]) ** 2, axis=0))
+        true_indices[q] = np.argsort(distances)[:k]
+    brute_time = (time.time() - start) / queries.shape[1]
+    print("Brute force: %fus/query" % (brute_time * 1.0E6))
+
+    print("Error bound, Query time [us], Speedup, Distances calculated [%], Recall")
+    for e in error_bounds:
+        start = time.time()
+        indices, _ = index.query(queries, k, e)
+        query_time = (time.time() - start) / queries.shape[1]
+        recall = np.mean([len(np.intersect1d(i, t)) for i, t in zip(indices, true_indices)]) / k
+        print("%g, %f, %f, %f, %f" % (e, query_time * 1.0E6, brute_time / query_time,
+                                      (100.0 * index.num_distances) / (queries.shape[1] * len(index)), recall))
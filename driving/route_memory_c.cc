@@ -0,0 +1,159 @@
+// Standard C++ includes
+#include <exception>
+#include <string>
+
+// Standard C includes
+#include <cstddef>
+#include <cstdint>
+
+// Driving includes
+#include "pyramid_route_memory.h"
+#include "route_memory.h"
+#include "spherical_harmonics.h"
+#include "vp_tree.h"
+
+//----------------------------------------------------------------------------
+// C API used by route_memory.py
+//----------------------------------------------------------------------------
+// **NOTE** exceptions can't propagate through ctypes so functions which can fail
+// return 0 on success or -1 on failure (or a null pointer from the create functions),
+// leaving a message in route_memory_get_last_error
+namespace
+{
+thread_local std::string lastError;
+
+template<typename F>
+int handleErrors(F f)
+{
+    try {
+        f();
+        return 0;
+    }
+    catch(const std::exception &ex) {
+        lastError = ex.what();
+        return -1;
+    }
+}
+}   // Anonymous namespace
+
+extern "C"
+{
+const char *route_memory_get_last_error()
+{
+    return lastError.c_str();
+}
+
+RouteMemory *route_memory_create(unsigned int width, unsigned int height, unsigned int numThreads)
+{
+    RouteMemory *routeMemory = nullptr;
+    handleErrors([&](){ routeMemory = new RouteMemory(width, height, numThreads); });
+    return routeMemory;
+}
+
+void route_memory_destroy(RouteMemory *routeMemory)
+{
+    delete routeMemory;
+}
+
+int route_memory_add_snapshots(RouteMemory *routeMemory, const uint8_t *images, size_t numSnapshots)
+{
+    return handleErrors([=](){ routeMemory->addSnapshots(images, numSnapshots); });
+}
+
+size_t route_memory_get_num_snapshots(const RouteMemory *routeMemory)
+{
+    return routeMemory->getNumSnapshots();
+}
+
+int route_memory_calc_idf(const RouteMemory *routeMemory, const uint8_t *images, size_t numImages, double *differences)
+{
+    return handleErrors([=](){ routeMemory->calcIDF(images, numImages, differences); });
+}
+
+int route_memory_calc_ridf(const RouteMemory *routeMemory, const uint8_t *image, double *differences)
+{
+    return handleErrors([=](){ routeMemory->calcRIDF(image, differences); });
+}
+
+int route_memory_calc_best_rotations(const RouteMemory *routeMemory, const uint8_t *image,
+                                     unsigned int *bestRotations, double *minDifferences)
+{
+    return handleErrors([=](){ routeMemory->calcBestRotations(image, bestRotations, minDifferences); });
+}
+
+SphericalHarmonicExtractor *spherical_harmonics_create(unsigned int width, unsigned int height, unsigned int maxDegree,
+                                                       double verticalFOV, unsigned int numThreads)
+{
+    SphericalHarmonicExtractor *extractor = nullptr;
+    handleErrors([&](){ extractor = new SphericalHarmonicExtractor(width, height, maxDegree, verticalFOV, numThreads); });
+    return extractor;
+}
+
+void spherical_harmonics_destroy(SphericalHarmonicExtractor *extractor)
+{
+    delete extractor;
+}
+
+unsigned int spherical_harmonics_get_num_coefficients(const SphericalHarmonicExtractor *extractor)
+{
+    return extractor->getNumCoefficients();
+}
+
+int spherical_harmonics_extract(const SphericalHarmonicExtractor *extractor, const uint8_t *images, size_t numImages,
+                                double *coefficients)
+{
+    return handleErrors([=](){ extractor->extract(images, numImages, coefficients); });
+}
+
+VPTree *vp_tree_create(const double *descriptors, size_t numItems, unsigned int numDimensions,
+                       unsigned int leafSize, unsigned int numThreads)
+{
+    VPTree *tree = nullptr;
+    handleErrors([&](){ tree = new VPTree(descriptors, numItems, numDimensions, leafSize, numThreads); });
+    return tree;
+}
+
+void vp_tree_destroy(VPTree *tree)
+{
+    delete tree;
+}
+
+int vp_tree_query(const VPTree *tree, const double *queries, size_t numQueries, unsigned int k, double errorBound,
+                  size_t *indices, double *distances, size_t *numDistances)
+{
+    return handleErrors([=](){ *numDistances = tree->query(queries, numQueries, k, errorBound, indices, distances); });
+}
+
+PyramidRouteMemory *pyramid_route_memory_create(unsigned int width, unsigned int height, unsigned int numThreads)
+{
+    PyramidRouteMemory *pyramidRouteMemory = nullptr;
+    handleErrors([&](){ pyramidRouteMemory = new PyramidRouteMemory(width, height, numThreads); });
+    return pyramidRouteMemory;
+}
+
+void pyramid_route_memory_destroy(PyramidRouteMemory *pyramidRouteMemory)
+{
+    delete pyramidRouteMemory;
+}
+
+const RouteMemory *pyramid_route_memory_get_route_memory(const PyramidRouteMemory *pyramidRouteMemory)
+{
+    return &pyramidRouteMemory->getRouteMemory();
+}
+
+int pyramid_route_memory_add_snapshots(PyramidRouteMemory *pyramidRouteMemory, const uint8_t *images, size_t numSnapshots)
+{
+    return handleErrors([=](){ pyramidRouteMemory->addSnapshots(images, numSnapshots); });
+}
+
+int pyramid_route_memory_calc_best_matches(const PyramidRouteMemory *pyramidRouteMemory, const uint8_t *images,
+                                           size_t numImages, unsigned int k, size_t *indices, double *differences,
+                                           size_t *numComparisons)
+{
+    return handleErrors(
+        [=]()
+        {
+            *numComparisons = pyramidRouteMemory->calcBestMatches(images, numImages, k, indices, differences);
+        });
+}
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+
+// Driving includes
+#include "parallel_for.h"
+
+//----------------------------------------------------------------------------
+// SphericalHarmonicExtractor
+//----------------------------------------------------------------------------
+//! Projects panoramic greyscale images onto real spherical harmonics up to degree maxDegree
+/*! Images are treated as equirectangular: columns span 360 degrees of azimuth and rows span verticalFOV
+    radians of elevation, centred on the horizon, with row 0 at the top. By default, pixels are square so,
+    for the 450x50 snapshots in drive.ipynb, the image covers 20 degrees above and below the horizon.
+    Coefficients are ordered by degree l and then order m from -l to l, like image2sphcoef's output,
+    so there are (maxDegree + 1)^2 of them - 36 for the default maxDegree of 5.
+
+    Real spherical harmonics are separable into a function of polar angle and one of azimuth so,
+    rather than a full basis image per coefficient, only per-column cos(m phi) and sin(m phi) tables
+    and per-row tables of normalised associated Legendre functions weighted by each row's solid
+    angle are needed. Each image row is first reduced to 2 * maxDegree + 1 azimuthal sums and these
+    are then combined with the row tables. Pixel intensities are scaled to [0, 1]. */
+class SphericalHarmonicExtractor
+{
+public:
+    SphericalHarmonicExtractor(unsigned int width, unsigned int height, unsigned int maxDegree = 5,
+                               double verticalFOV = 0.0, unsigned int numThreads = 0)
+    :   m_Width(width), m_Height(height), m_MaxDegree(maxDegree),
+        m_NumThreads(getDefaultNumThreads(numThreads)),
+        m_AzimuthTable(getNumOrders() * width), m_PolarTable(getNumCoefficients() * height)
+    {
+        if(width == 0 || height == 0) {
+            throw std::runtime_error("Cannot create SphericalHarmonicExtractor for empty images");
+        }
+
+        const double pi = 3.14159265358979323846;
+        const double pixelAzimuth = (2.0 * pi) / (double)width;
+        const double pixelPolar = ((verticalFOV == 0.0) ? (pixelAzimuth * (double)height) : verticalFOV) / (double)height;
+        const double polarBegin = (pi - (pixelPolar * (double)height)) / 2.0;
+
+        // Azimuthal table - entry m + maxDegree is sin(|m| phi) for m < 0, 1 for m = 0 and cos(m phi) for m > 0
+        for(unsigned int x = 0; x < width; x++) {
+            const double phi = ((double)x + 0.5) * pixelAzimuth;
+            for(int m = -(int)maxDegree; m <= (int)maxDegree; m++) {
+                const double value = (m < 0) ? std::sin(-m * phi) : ((m == 0) ? 1.0 : std::cos(m * phi));
+                m_AzimuthTable[((m + maxDegree) * width) + x] = (float)value;
+            }
+        }
+
+        // Polar table - normalised associated Legendre function for each coefficient multiplied by
+        // pixel solid angle sin(theta) dtheta dphi and, for m != 0, the sqrt(2) of real harmonics
+        for(unsigned int y = 0; y < height; y++) {
+            const double theta = polarBegin + (((double)y + 0.5) * pixelPolar);
+            const double solidAngle = std::sin(theta) * pixelPolar * pixelAzimuth;
+            for(unsigned int l = 0; l <= maxDegree; l++) {
+                for(int m = -(int)l; m <= (int)l; m++) {
+                    const unsigned int absM = (unsigned int)std::abs(m);
+                    const double scale = (m == 0) ? 1.0 : std::sqrt(2.0);
+                    const double value = scale * getNormalisation(l, absM) * getLegendre(l, absM, std::cos(theta)) * solidAngle;
+                    m_PolarTable[(getCoefficientIndex(l, m) * height) + y] = value;
+                }
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Calculate getNumCoefficients() coefficients of image
+    void extract(const uint8_t *image, double *coefficients) const
+    {
+        std::vector<float> row(m_Width);
+        std::vector<double> rowSums(getNumOrders() * m_Height);
+        extract(image, row.data(), rowSums.data(), coefficients);
+    }
+
+    //! Calculate coefficients of numImages contiguous images in parallel, writing
+    //! a numImages x getNumCoefficients() row-major matrix
+    void extract(const uint8_t *images, size_t numImages, double *coefficients) const
+    {
+        parallelFor(numImages, m_NumThreads,
+                    [this, images, coefficients](size_t begin, size_t end)
+                    {
+                        std::vector<float> row(m_Width);
+                        std::vector<double> rowSums(getNumOrders() * m_Height);
+                        for(size_t i = begin; i < end; i++) {
+                            extract(&images[i * m_Width * m_Height], row.data(), rowSums.data(),
+                                    &coefficients[i * getNumCoefficients()]);
+                        }
+                    });
+    }
+
+    unsigned int getWidth() const{ return m_Width; }
+    unsigned int getHeight() const{ return m_Height; }
+    unsigned int getMaxDegree() const{ return m_MaxDegree; }
+    unsigned int getNumCoefficients() const{ return (m_MaxDegree + 1) * (m_MaxDegree + 1); }
+
+    //! Index of coefficient of degree l and order m
+    static unsigned int getCoefficientIndex(unsigned int l, int m){ return (l * l) + l + m; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    //! Independent accumulators used for azimuthal sums - enough to fill two AVX registers
+    static constexpr unsigned int numLanes = 16;
+
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    //! sqrt(((2l + 1) / 4 pi) * ((l - m)! / (l + m)!))
+    static double getNormalisation(unsigned int l, unsigned int m)
+    {
+        double factorialRatio = 1.0;
+        for(unsigned int k = l - m + 1; k <= l + m; k++) {
+            factorialRatio /= (double)k;
+        }
+        return std::sqrt(((2.0 * l + 1.0) / (4.0 * 3.14159265358979323846)) * factorialRatio);
+    }
+
+    //! Associated Legendre function P_l^m(x) (with Condon-Shortley phase) using standard recurrences
+    static double getLegendre(unsigned int l, unsigned int m, double x)
+    {
+        // P_m^m
+        double pmm = 1.0;
+        const double somx2 = std::sqrt((1.0 - x) * (1.0 + x));
+        for(unsigned int i = 1; i <= m; i++) {
+            pmm *= -(2.0 * i - 1.0) * somx2;
+        }
+        if(l == m) {
+            return pmm;
+        }
+
+        // P_{m+1}^m
+        double pmmp1 = x * (2.0 * m + 1.0) * pmm;
+        if(l == (m + 1)) {
+            return pmmp1;
+        }
+
+        // Recur upwards to P_l^m
+        double pll = 0.0;
+        for(unsigned int ll = m + 2; ll <= l; ll++) {
+            pll = ((x * (2.0 * ll - 1.0) * pmmp1) - ((ll + m - 1.0) * pmm)) / (double)(ll - m);
+            pmm = pmmp1;
+            pmmp1 = pll;
+        }
+        return pll;
+    }
+
+    //! Dot product of n floats
+    static float dot(const float *a, const float *b, unsigned int n)
+    {
+        // **NOTE** without -ffast-math, compilers won't reorder a single float sum so
+        // independent lane accumulators are required for the loop to be vectorised
+        float lanes[numLanes] = {};
+        unsigned int i = 0;
+        for(; (i + numLanes) <= n; i += numLanes) {
+            for(unsigned int l = 0; l < numLanes; l++) {
+                lanes[l] += a[i + l] * b[i + l];
+            }
+        }
+        float sum = std::accumulate(std::begin(lanes), std::end(lanes), 0.0f);
+        for(; i < n; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    unsigned int getNumOrders() const{ return (2 * m_MaxDegree) + 1; }
+
+    void extract(const uint8_t *image, float *row, double *rowSums, double *coefficients) const
+    {
+        // Reduce each row to azimuthal sums for each order
+        const unsigned int numOrders = getNumOrders();
+        for(unsigned int y = 0; y < m_Height; y++) {
+            std::transform(&image[y * m_Width], &image[(y + 1) * m_Width], row,
+                           [](uint8_t p){ return (float)p; });
+            for(unsigned int o = 0; o < numOrders; o++) {
+                rowSums[(o * m_Height) + y] = (double)dot(&m_AzimuthTable[o * m_Width], row, m_Width) / 255.0;
+            }
+        }
+
+        // Combine row sums with polar tables
+        for(unsigned int l = 0; l <= m_MaxDegree; l++) {
+            for(int m = -(int)l; m <= (int)l; m++) {
+                const unsigned int c = getCoefficientIndex(l, m);
+                const double *polar = &m_PolarTable[c * m_Height];
+                const double *sums = &rowSums[(m + m_MaxDegree) * m_Height];
+                double coefficient = 0.0;
+                for(unsigned int y = 0; y < m_Height; y++) {
+                    coefficient += polar[y] * sums[y];
+                }
+                coefficients[c] = coefficient;
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_Width;
+    const unsigned int m_Height;
+    const unsigned int m_MaxDegree;
+    const unsigned int m_NumThreads;
+
+    //! (2 * maxDegree + 1) x width table of azimuthal basis functions
+    std::vector<float> m_AzimuthTable;
+
+    //! numCoefficients x height table of polar basis functions weighted by solid angle
+    std::vector<double> m_PolarTable;
+};
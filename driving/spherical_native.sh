@@ -0,0 +1,9 @@
+#!/bin/bash
+# Extract spherical harmonic coefficients of every image in each route into <route>/spherical.npy using the
+# native extractor in route_memory.py. **NOTE** coefficients are not identical to image2sphcoef's so, unlike
+# spherical.sh, this doesn't produce the CSV files read by drive.ipynb's load_spherical - use route_memory.load_spherical
+for r in */; do
+    if ls "$r"image_*.png > /dev/null 2>&1; then
+        python3 -c "import sys; from route_memory import extract_spherical; extract_spherical(sys.argv[1])" "${r%/}"
+    fi
+done
@@ -0,0 +1,239 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstddef>
+
+// Driving includes
+#include "parallel_for.h"
+
+//----------------------------------------------------------------------------
+// VPTree
+//----------------------------------------------------------------------------
+//! Vantage-point tree for k-nearest-neighbour queries over snapshot descriptors by Euclidean distance
+/*! Each node picks a vantage point and splits the remaining descriptors at the median distance from
+    it. The triangle inequality then lets whole subtrees be skipped when a query's distance to the vantage
+    point shows they can't contain anything closer than the current k-th nearest neighbour. Unlike k-d trees,
+    splits don't align with axes so pruning stays effective for 35-dimensional spherical harmonic descriptors
+    and, because descriptors along a route lie close to a one-dimensional curve, queries typically only
+    visit a few leaves. Descriptors are copied into tree order so each leaf is scanned contiguously.
+
+    With errorBound = 0, queries are exact. Otherwise subtrees are pruned against the k-th distance
+    divided by (1 + errorBound) so every neighbour returned is within that factor of the true one. */
+class VPTree
+{
+public:
+    //! Build tree over numItems descriptors, each of numDimensions values stored contiguously
+    VPTree(const double *descriptors, size_t numItems, unsigned int numDimensions,
+           unsigned int leafSize = 16, unsigned int numThreads = 0)
+    :   m_NumDimensions(numDimensions), m_LeafSize(std::max(1u, leafSize)), m_NumThreads(getDefaultNumThreads(numThreads)),
+        m_Order(numItems)
+    {
+        if(numItems == 0) {
+            throw std::runtime_error("Cannot build VPTree with no descriptors");
+        }
+
+        // Build tree over permutation of item indices
+        std::iota(m_Order.begin(), m_Order.end(), 0);
+        std::mt19937 rng(0);
+        build(descriptors, 0, numItems, rng);
+
+        // Copy descriptors into tree order
+        m_Descriptors.resize(numItems * numDimensions);
+        for(size_t i = 0; i < numItems; i++) {
+            std::copy_n(&descriptors[m_Order[i] * numDimensions], numDimensions, &m_Descriptors[i * numDimensions]);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Find k nearest items to each of numQueries contiguous queries in parallel, writing numQueries x k
+    //! row-major matrices of item indices and distances, nearest first. If k exceeds the number
+    //! of items, surplus indices are set to getNumItems() and distances to infinity.
+    //! Returns the total number of distances calculated.
+    size_t query(const double *queries, size_t numQueries, unsigned int k, double errorBound,
+                 size_t *indices, double *distances) const
+    {
+        std::vector<size_t> numDistances(numQueries);
+        parallelFor(numQueries, m_NumThreads,
+                    [this, queries, k, errorBound, indices, distances, &numDistances](size_t begin, size_t end)
+                    {
+                        Neighbours neighbours;
+                        for(size_t q = begin; q < end; q++) {
+                            numDistances[q] = query(&queries[q * m_NumDimensions], k, errorBound, neighbours);
+
+                            // Sort neighbours by distance and write out
+                            std::sort_heap(neighbours.begin(), neighbours.end());
+                            for(unsigned int i = 0; i < k; i++) {
+                                const bool valid = (i < neighbours.size());
+                                indices[(q * k) + i] = valid ? m_Order[neighbours[i].second] : getNumItems();
+                                distances[(q * k) + i] = valid ? neighbours[i].first : std::numeric_limits<double>::infinity();
+                            }
+                        }
+                    });
+        return std::accumulate(numDistances.cbegin(), numDistances.cend(), size_t{0});
+    }
+
+    size_t getNumItems() const{ return m_Order.size(); }
+    unsigned int getNumDimensions() const{ return m_NumDimensions; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Node
+    //----------------------------------------------------------------------------
+    //! Tree node covering items [begin, end) in tree order. In internal nodes, item begin is the vantage point,
+    //! items up to split are within radius of it and the remainder beyond. Leaves have no children.
+    struct Node
+    {
+        size_t begin;
+        size_t split;
+        size_t end;
+        double radius;
+        int inner;
+        int outer;
+    };
+
+    //! Max-heap of (distance, tree-order index) pairs
+    typedef std::vector<std::pair<double, size_t>> Neighbours;
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    double calcDistance(const double *a, const double *b) const
+    {
+        double sum = 0.0;
+        for(unsigned int d = 0; d < m_NumDimensions; d++) {
+            const double diff = a[d] - b[d];
+            sum += diff * diff;
+        }
+        return std::sqrt(sum);
+    }
+
+    //! Recursively build subtree over m_Order[begin, end), returning its node index
+    int build(const double *descriptors, size_t begin, size_t end, std::mt19937 &rng)
+    {
+        const int nodeIndex = (int)m_Nodes.size();
+        m_Nodes.push_back(Node{begin, end, end, 0.0, -1, -1});
+        if((end - begin) <= m_LeafSize) {
+            return nodeIndex;
+        }
+
+        // Move randomly chosen vantage point to start of range
+        std::uniform_int_distribution<size_t> vantageDist(begin, end - 1);
+        std::swap(m_Order[begin], m_Order[vantageDist(rng)]);
+        const double *vantage = &descriptors[m_Order[begin] * m_NumDimensions];
+
+        // Partition remaining items around median distance from vantage point
+        const size_t split = begin + 1 + ((end - begin - 1) / 2);
+        std::vector<std::pair<double, size_t>> itemDistances;
+        itemDistances.reserve(end - begin - 1);
+        for(size_t i = begin + 1; i < end; i++) {
+            itemDistances.emplace_back(calcDistance(vantage, &descriptors[m_Order[i] * m_NumDimensions]), m_Order[i]);
+        }
+        std::nth_element(itemDistances.begin(), itemDistances.begin() + (split - begin - 1), itemDistances.end());
+        for(size_t i = begin + 1; i < end; i++) {
+            m_Order[i] = itemDistances[i - begin - 1].second;
+        }
+
+        // **NOTE** m_Nodes may reallocate during recursion so nodes are only accessed by index
+        m_Nodes[nodeIndex].split = split;
+        m_Nodes[nodeIndex].radius = itemDistances[split - begin - 1].first;
+        const int inner = build(descriptors, begin + 1, split, rng);
+        const int outer = build(descriptors, split, end, rng);
+        m_Nodes[nodeIndex].inner = inner;
+        m_Nodes[nodeIndex].outer = outer;
+        return nodeIndex;
+    }
+
+    //! Offer tree-order item i at given distance as a neighbour
+    static void addNeighbour(Neighbours &neighbours, unsigned int k, double distance, size_t i)
+    {
+        if(neighbours.size() < k) {
+            neighbours.emplace_back(distance, i);
+            std::push_heap(neighbours.begin(), neighbours.end());
+        }
+        else if(distance < neighbours.front().first) {
+            std::pop_heap(neighbours.begin(), neighbours.end());
+            neighbours.back() = std::make_pair(distance, i);
+            std::push_heap(neighbours.begin(), neighbours.end());
+        }
+    }
+
+    //! Find k nearest neighbours of query, returning number of distances calculated
+    size_t query(const double *query, unsigned int k, double errorBound, Neighbours &neighbours) const
+    {
+        neighbours.clear();
+        if(k == 0) {
+            return 0;
+        }
+
+        size_t numDistances = 0;
+        const double pruneScale = 1.0 / (1.0 + errorBound);
+        search(0, query, k, pruneScale, neighbours, numDistances);
+        return numDistances;
+    }
+
+    void search(int nodeIndex, const double *query, unsigned int k, double pruneScale,
+                Neighbours &neighbours, size_t &numDistances) const
+    {
+        const Node &node = m_Nodes[nodeIndex];
+
+        // Scan leaves
+        if(node.inner == -1) {
+            for(size_t i = node.begin; i < node.end; i++) {
+                addNeighbour(neighbours, k, calcDistance(query, &m_Descriptors[i * m_NumDimensions]), i);
+            }
+            numDistances += node.end - node.begin;
+            return;
+        }
+
+        const double distance = calcDistance(query, &m_Descriptors[node.begin * m_NumDimensions]);
+        numDistances++;
+        addNeighbour(neighbours, k, distance, node.begin);
+
+        // Search side of boundary query is on first, then the other side if the
+        // (scaled) search radius still crosses the boundary once the first is searched
+        auto getTau =
+            [&neighbours, k, pruneScale]()
+            {
+                return (neighbours.size() < k) ? std::numeric_limits<double>::infinity() : (neighbours.front().first * pruneScale);
+            };
+        if(distance < node.radius) {
+            search(node.inner, query, k, pruneScale, neighbours, numDistances);
+            if((distance + getTau()) >= node.radius) {
+                search(node.outer, query, k, pruneScale, neighbours, numDistances);
+            }
+        }
+        else {
+            search(node.outer, query, k, pruneScale, neighbours, numDistances);
+            if((distance - getTau()) <= node.radius) {
+                search(node.inner, query, k, pruneScale, neighbours, numDistances);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_NumDimensions;
+    const unsigned int m_LeafSize;
+    const unsigned int m_NumThreads;
+
+    //! Original index of each item in tree order
+    std::vector<size_t> m_Order;
+
+    //! Descriptors in tree order, stored contiguously
+    std::vector<double> m_Descriptors;
+
+    std::vector<Node> m_Nodes;
+};
@@ -1,3 +1,7 @@
+// Standard C++ includes
+#include <fstream>
+#include <iostream>
+
 // GeNN robotics includes
 #include "analogue_csv_recorder.h"
 #include "spike_csv_recorder.h"
@@ -7,6 +11,9 @@
 
 #include "simulator_common.h"
 
+// Common includes
+#include "../common/snapshot.h"
+
 //----------------------------------------------------------------------------
 // Anonymous namespace
 //----------------------------------------------------------------------------
@@ -46,8 +53,16 @@ void applyExperimentStimuli(scalar t, scalar red1, scalar blue1, scalar red2, sc
 }
 }   // Anonymous namespace
 
-int main()
+int main(int argc, char *argv[])
 {
+    if(argc > 2) {
+        std::cerr << "Usage: simulator [<warmup state file>]" << std::endl;
+        std::cerr << "If the warmup state file exists, the initial transient is restored from it rather than simulated" << std::endl;
+        std::cerr << "so spikes.csv, voltages.csv and stim.csv start at t=" << startTime << "ms. Otherwise the transient" << std::endl;
+        std::cerr << "is simulated and recorded as normal and the state at t=" << startTime << "ms is saved to it." << std::endl;
+        return 1;
+    }
+
     const scalar leftValue = 0.55f;
     const scalar rightValue = 0.45f;
    
@@ -61,6 +76,36 @@ int main()
     AnalogueCSVRecorder<scalar> voltages("voltages.csv", VNeurons, 5, "Membrane voltage [mV]");
 
     std::ofstream stimuli("stim.csv");
+
+    // If a warmup state file is specified
+    if(argc > 1) {
+        Snapshot snapshot;
+        addModelStateToSnapshot(snapshot);
+
+        // If it exists, restore state at the start of the first experiment
+        // **NOTE** the transient isn't simulated so nothing is recorded before startTime
+        if(std::ifstream(argv[1]).good()) {
+            snapshot.load(argv[1]);
+            snapshot.restore();
+            std::cout << "Restored warmup state from '" << argv[1] << "' - recording starts at t=" << t << "ms" << std::endl;
+        }
+        // Otherwise, simulate and record initial transient and save
+        else {
+            while(t < startTime) {
+                setRedInput(0.0f);
+                setBlueInput(0.0f);
+
+                stimuli << gExtExcitatorySyn[2] << ", " << gExtExcitatorySyn[1] << std::endl;
+
+                stepTimeCPU();
+
+                spikes.record(t);
+                voltages.record(t);
+            }
+            snapshot.capture();
+            snapshot.save(argv[1]);
+        }
+    }
     
     // Loop through timesteps
     while(t < 800.0f) {
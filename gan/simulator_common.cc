@@ -3,6 +3,9 @@
 // Auto-generated model code
 #include "chama_gan_CODE/definitions.h"
 
+// Common includes
+#include "../common/snapshot.h"
+
 constexpr float gScale = 3.6f;
 
 void setExcitatoryWeight(unsigned int preIdx, unsigned int postIdx, scalar weight)
@@ -49,4 +52,23 @@ void initConnectivity()
     setInhibitoryWeight(2, 0, -2.67f);
     
     initchama_gan();
+}
+
+void addModelStateToSnapshot(Snapshot &snapshot)
+{
+    // Simulation time
+    snapshot.addVariable(&t);
+    snapshot.addVariable(&iT);
+
+    // Neuron state and spikes
+    snapshot.addVariable(VNeurons, 5);
+    snapshot.addVariable(WNeurons, 5);
+    snapshot.addVariable(glbSpkCntNeurons, 1);
+    snapshot.addVariable(glbSpkNeurons, 5);
+
+    // Postsynaptic conductances and external input
+    snapshot.addVariable(inSynExcitatorySyn, 5);
+    snapshot.addVariable(inSynInhibitorySyn, 5);
+    snapshot.addVariable(gExtExcitatorySyn, 5);
+    snapshot.addVariable(gExtInhibitorySyn, 5);
 }
\ No newline at end of file
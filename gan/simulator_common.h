@@ -1,9 +1,12 @@
 #pragma once
 
+// Forward declarations
+class Snapshot;
 
 void setExcitatoryWeight(unsigned int preIdx, unsigned int postIdx, float weight);
 void setInhibitoryWeight(unsigned int preIdx, unsigned int postIdx, float weight);
 void setBlueInput(float value);
 void setRedInput(float value);
 
-void initConnectivity();
\ No newline at end of file
+void initConnectivity();
+void addModelStateToSnapshot(Snapshot &snapshot);
\ No newline at end of file
@@ -0,0 +1,73 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+
+// Standard C includes
+#include <cstdlib>
+
+// Model includes
+#include "grid_layout.h"
+#include "grid_network.h"
+#include "parameters.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+typedef TiledLayout<> Layout;
+
+const unsigned int worldSizes[] = {64, 128, 256, 512, 1024, 2048};
+
+// Current used to stimulate bump and hold direction neurons active (nA)
+const float stimulusCurrent = 10.0f;
+
+const unsigned int numWarmupTimesteps = 20;
+
+void benchmark(unsigned int size, bool activeSet, unsigned int bumpRadius, unsigned int numTimesteps)
+{
+    GridNetwork<Layout> network(size, size, true, activeSet);
+
+    // Keep all direction neurons active so interneurons are inhibited
+    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+        network.getDirection().setIExt(d, stimulusCurrent);
+    }
+
+    // Continuously stimulate a square patch in the centre of the world to maintain a localised bump
+    for(unsigned int y = (size / 2) - bumpRadius; y <= (size / 2) + bumpRadius; y++) {
+        for(unsigned int x = (size / 2) - bumpRadius; x <= (size / 2) + bumpRadius; x++) {
+            network.getPosition().setIExt(network.getLayout().getIndex(x, y), stimulusCurrent);
+        }
+    }
+
+    for(unsigned int t = 0; t < numWarmupTimesteps; t++) {
+        network.step();
+    }
+
+    unsigned long long numPositionSpikes = 0;
+    unsigned long long numNeuronUpdates = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        numNeuronUpdates += network.getNumActive();
+        network.step();
+        numPositionSpikes += network.getPosition().getSpikes().size();
+    }
+    const std::chrono::duration<double, std::micro> duration = std::chrono::high_resolution_clock::now() - start;
+
+    std::cout << (activeSet ? "active-set" : "dense") << ", " << size << ", " << duration.count() / (double)numTimesteps << ", "
+        << numNeuronUpdates / numTimesteps << ", " << numPositionSpikes << std::endl;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int bumpRadius = (argc > 1) ? std::atoi(argv[1]) : 2;
+    const unsigned int numTimesteps = (argc > 2) ? std::atoi(argv[2]) : 50;
+
+    std::cout << "Mode, World size, Step time [us], Neuron updates per timestep, Position spikes" << std::endl;
+    for(unsigned int size : worldSizes) {
+        benchmark(size, false, bumpRadius, numTimesteps);
+        benchmark(size, true, bumpRadius, numTimesteps);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+
+// Standard C includes
+#include <cstdlib>
+
+// Model includes
+#include "grid_layout.h"
+#include "grid_network.h"
+#include "parameters.h"
+#include "random_stimulus.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+const unsigned int worldSizes[] = {64, 128, 256, 512, 1024, 2048};
+
+// Current used to stimulate position neurons and hold direction neurons active (nA)
+const float stimulusCurrent = 2.0f;
+
+const unsigned int numWarmupTimesteps = 20;
+
+template<typename Layout>
+void benchmark(unsigned int size, unsigned int fractionPercent, unsigned int numTimesteps)
+{
+    GridNetwork<Layout> network(size, size);
+
+    // Keep all direction neurons active so interneurons are inhibited
+    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+        network.getDirection().setIExt(d, stimulusCurrent);
+    }
+
+    // Stimulate a random subset of position neurons to generate activity across the whole world
+    for(unsigned int y = 0; y < size; y++) {
+        for(unsigned int x = 0; x < size; x++) {
+            if(isStimulated(x, y, fractionPercent)) {
+                network.getPosition().setIExt(network.getLayout().getIndex(x, y), stimulusCurrent);
+            }
+        }
+    }
+
+    for(unsigned int t = 0; t < numWarmupTimesteps; t++) {
+        network.step();
+    }
+
+    unsigned long long numPositionSpikes = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        network.step();
+        numPositionSpikes += network.getPosition().getSpikes().size();
+    }
+    const std::chrono::duration<double, std::micro> duration = std::chrono::high_resolution_clock::now() - start;
+
+    const double stepTime = duration.count() / (double)numTimesteps;
+    std::cout << Layout::getName() << ", " << size << ", " << network.getLayout().getNumNeurons() << ", "
+        << stepTime << ", " << (stepTime * 1000.0) / (double)(size * size) << ", " << numPositionSpikes << std::endl;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int fractionPercent = (argc > 1) ? std::atoi(argv[1]) : 10;
+    const unsigned int numTimesteps = (argc > 2) ? std::atoi(argv[2]) : 50;
+
+    std::cout << "Layout, World size, Neurons per population, Step time [us], Step time per cell [ns], Position spikes" << std::endl;
+    for(unsigned int size : worldSizes) {
+        benchmark<RowMajorLayout>(size, fractionPercent, numTimesteps);
+        benchmark<TiledLayout<>>(size, fractionPercent, numTimesteps);
+        benchmark<MortonLayout>(size, fractionPercent, numTimesteps);
+    }
+    return EXIT_SUCCESS;
+}
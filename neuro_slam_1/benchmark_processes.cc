@@ -0,0 +1,250 @@
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+// POSIX includes
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Model includes
+#include "distributed_grid_network.h"
+#include "grid_layout.h"
+#include "halo_transport.h"
+#include "parameters.h"
+#include "random_stimulus.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+typedef TiledLayout<> Layout;
+
+// Current used to stimulate position neurons and hold direction neurons active (nA)
+const float stimulusCurrent = 2.0f;
+
+// Percentage of position neurons to stimulate
+const unsigned int stimulusFractionPercent = 10;
+
+const unsigned int numWarmupTimesteps = 20;
+
+//! Written by each rank into shared memory
+struct RankResult
+{
+    double stepTime;
+    unsigned long long numPositionSpikes;
+};
+
+void printUsage()
+{
+    std::cerr << "Usage: benchmark_processes [--transport shared-memory|socket] [<size> [<number of timesteps> [<max processes>]]]" << std::endl;
+}
+
+//! Simulate rank's band of world, writing result
+template<typename Group>
+void runRank(Group &group, unsigned int rank, unsigned int width, unsigned int height, unsigned int numTimesteps,
+             RankResult &result)
+{
+    std::unique_ptr<HaloTransport> transport = group.getTransport(rank);
+    DistributedGridNetwork<Layout> network(width, height, *transport);
+
+    // Keep all direction neurons active so interneurons are inhibited
+    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+        network.setDirectionIExt((Parameters::Direction)d, stimulusCurrent);
+    }
+
+    // Stimulate a random subset of position neurons in this rank's band
+    for(unsigned int y = network.getRowBegin(); y < (network.getRowBegin() + network.getNumRows()); y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            if(isStimulated(x, y, stimulusFractionPercent)) {
+                network.setPositionIExt(x, y, stimulusCurrent);
+            }
+        }
+    }
+
+    // Warmup timesteps also synchronise ranks which may have taken different times to build their bands
+    for(unsigned int t = 0; t < numWarmupTimesteps; t++) {
+        network.step();
+    }
+
+    result.numPositionSpikes = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        network.step();
+        result.numPositionSpikes += network.getNumPositionSpikes();
+    }
+    const std::chrono::duration<double, std::micro> duration = std::chrono::high_resolution_clock::now() - start;
+    result.stepTime = duration.count() / (double)numTimesteps;
+}
+
+//! Fork a process for each rank and wait for them all, returning false if any fail
+template<typename Group>
+bool runProcesses(Group &group, unsigned int numProcesses, unsigned int width, unsigned int height,
+                  unsigned int numTimesteps, RankResult *results)
+{
+    std::vector<pid_t> pids;
+    for(unsigned int r = 0; r < numProcesses; r++) {
+        const pid_t pid = fork();
+        if(pid == -1) {
+            throw std::runtime_error("Cannot fork process: " + std::string(strerror(errno)));
+        }
+        else if(pid == 0) {
+            try {
+                runRank(group, r, width, height, numTimesteps, results[r]);
+            }
+            catch(const std::exception &ex) {
+                std::cerr << "Rank " << r << ": " << ex.what() << std::endl;
+                _exit(EXIT_FAILURE);
+            }
+            _exit(EXIT_SUCCESS);
+        }
+        pids.push_back(pid);
+    }
+
+    // Wait for processes - if one fails (or crashes), kill the others as they would wait for it forever
+    bool success = true;
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        int status;
+        pid_t pid;
+        do {
+            pid = wait(&status);
+        } while(pid == -1 && errno == EINTR);
+        if(pid == -1) {
+            throw std::runtime_error("Cannot wait for worker processes: " + std::string(strerror(errno)));
+        }
+        else if(!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            if(success) {
+                for(pid_t p : pids) {
+                    if(p != pid) {
+                        kill(p, SIGKILL);
+                    }
+                }
+            }
+            success = false;
+        }
+    }
+    return success;
+}
+
+//! Run world split between numProcesses, returning slowest rank's mean step time in microseconds and total position spikes
+bool benchmark(const std::string &transport, unsigned int width, unsigned int height, unsigned int numProcesses,
+               unsigned int numTimesteps, double &stepTime, unsigned long long &numPositionSpikes)
+{
+    // Allocate results in memory shared with worker processes
+    const size_t resultsSize = sizeof(RankResult) * numProcesses;
+    void *resultsData = mmap(nullptr, resultsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(resultsData == MAP_FAILED) {
+        throw std::runtime_error("Cannot create shared memory for results");
+    }
+    RankResult *results = reinterpret_cast<RankResult*>(resultsData);
+
+    bool success;
+    if(transport == "socket") {
+        SocketHaloTransport::Group group(numProcesses);
+        success = runProcesses(group, numProcesses, width, height, numTimesteps, results);
+    }
+    else {
+        SharedMemoryHaloTransport::Group group(numProcesses, width);
+        success = runProcesses(group, numProcesses, width, height, numTimesteps, results);
+    }
+
+    stepTime = 0.0;
+    numPositionSpikes = 0;
+    for(unsigned int r = 0; r < numProcesses; r++) {
+        stepTime = std::max(stepTime, results[r].stepTime);
+        numPositionSpikes += results[r].numPositionSpikes;
+    }
+    munmap(resultsData, resultsSize);
+    return success;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    std::string transport = "shared-memory";
+    int a = 1;
+    if(a < argc && std::strcmp(argv[a], "--transport") == 0 && (a + 1) < argc) {
+        transport = argv[a + 1];
+        a += 2;
+    }
+    if(transport != "shared-memory" && transport != "socket") {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const unsigned int size = (argc > a) ? std::atoi(argv[a]) : 2048;
+    const unsigned int numTimesteps = (argc > (a + 1)) ? std::atoi(argv[a + 1]) : 50;
+    const unsigned int maxProcesses = (argc > (a + 2)) ? std::atoi(argv[a + 2]) : std::max(1u, std::thread::hardware_concurrency());
+    if(size == 0 || maxProcesses == 0 || maxProcesses > size) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    // Test powers of two up to maximum and maximum itself
+    std::vector<unsigned int> processCounts;
+    for(unsigned int n = 1; n < maxProcesses; n *= 2) {
+        processCounts.push_back(n);
+    }
+    processCounts.push_back(maxProcesses);
+
+    // Strong scaling - the same world split between more processes
+    std::cout << "Strong scaling: " << size << "x" << size << " world, " << transport << " transport" << std::endl;
+    std::cout << "Processes, Step time [us], Speedup, Parallel efficiency, Position spikes" << std::endl;
+    double singleProcessStepTime = 0.0;
+    unsigned long long singleProcessSpikes = 0;
+    for(unsigned int numProcesses : processCounts) {
+        double stepTime;
+        unsigned long long numPositionSpikes;
+        if(!benchmark(transport, size, size, numProcesses, numTimesteps, stepTime, numPositionSpikes)) {
+            std::cerr << "Worker process failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if(numProcesses == 1) {
+            singleProcessStepTime = stepTime;
+            singleProcessSpikes = numPositionSpikes;
+        }
+
+        const double speedup = singleProcessStepTime / stepTime;
+        std::cout << numProcesses << ", " << stepTime << ", " << speedup << ", " << speedup / (double)numProcesses << ", "
+            << numPositionSpikes << std::endl;
+
+        // As with threads, partitioning changes the order inSyn contributions are summed in
+        // so activity can differ very slightly but not by more than a handful of spikes
+        if(std::llabs((long long)numPositionSpikes - (long long)singleProcessSpikes) > (long long)(singleProcessSpikes / 1000)) {
+            std::cerr << "Distributed activity diverged from single-process activity" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Weak scaling - each process always simulates the same number of rows
+    const unsigned int rowsPerProcess = size / maxProcesses;
+    std::cout << std::endl << "Weak scaling: " << size << " wide world, " << rowsPerProcess << " rows per process (height grows with processes), " << transport << " transport" << std::endl;
+    std::cout << "Processes, World height, Step time [us], Parallel efficiency, Position spikes" << std::endl;
+    for(unsigned int numProcesses : processCounts) {
+        double stepTime;
+        unsigned long long numPositionSpikes;
+        if(!benchmark(transport, size, rowsPerProcess * numProcesses, numProcesses, numTimesteps, stepTime, numPositionSpikes)) {
+            std::cerr << "Worker process failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if(numProcesses == 1) {
+            singleProcessStepTime = stepTime;
+        }
+
+        std::cout << numProcesses << ", " << rowsPerProcess * numProcesses << ", " << stepTime << ", "
+            << singleProcessStepTime / stepTime << ", " << numPositionSpikes << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
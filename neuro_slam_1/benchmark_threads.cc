@@ -0,0 +1,103 @@
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Model includes
+#include "grid_layout.h"
+#include "parameters.h"
+#include "partitioned_grid_network.h"
+#include "random_stimulus.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+typedef TiledLayout<> Layout;
+
+// Current used to stimulate position neurons and hold direction neurons active (nA)
+const float stimulusCurrent = 2.0f;
+
+// Percentage of position neurons to stimulate
+const unsigned int stimulusFractionPercent = 10;
+
+const unsigned int numWarmupTimesteps = 20;
+
+//! Run network with numThreads, returning mean step time in microseconds and total position spikes
+double benchmark(unsigned int size, unsigned int numThreads, unsigned int numTimesteps, unsigned long long &numPositionSpikes)
+{
+    PartitionedGridNetwork<Layout> network(size, size, numThreads);
+
+    // Keep all direction neurons active so interneurons are inhibited
+    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+        network.setDirectionIExt((Parameters::Direction)d, stimulusCurrent);
+    }
+
+    // Stimulate a random subset of position neurons to generate activity across the whole world
+    for(unsigned int y = 0; y < size; y++) {
+        for(unsigned int x = 0; x < size; x++) {
+            if(isStimulated(x, y, stimulusFractionPercent)) {
+                network.setPositionIExt(x, y, stimulusCurrent);
+            }
+        }
+    }
+
+    for(unsigned int t = 0; t < numWarmupTimesteps; t++) {
+        network.step();
+    }
+
+    numPositionSpikes = 0;
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        network.step();
+        numPositionSpikes += network.getNumPositionSpikes();
+    }
+    const std::chrono::duration<double, std::micro> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count() / (double)numTimesteps;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int size = (argc > 1) ? std::atoi(argv[1]) : 2048;
+    const unsigned int numTimesteps = (argc > 2) ? std::atoi(argv[2]) : 50;
+    const unsigned int maxThreads = (argc > 3) ? std::atoi(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+
+    // Test powers of two up to maximum and maximum itself
+    std::vector<unsigned int> threadCounts;
+    for(unsigned int n = 1; n < maxThreads; n *= 2) {
+        threadCounts.push_back(n);
+    }
+    threadCounts.push_back(maxThreads);
+
+    std::cout << size << "x" << size << " world" << std::endl;
+    std::cout << "Threads, Step time [us], Speedup, Parallel efficiency, Position spikes" << std::endl;
+    double singleThreadStepTime = 0.0;
+    unsigned long long singleThreadSpikes = 0;
+    for(unsigned int numThreads : threadCounts) {
+        unsigned long long numPositionSpikes;
+        const double stepTime = benchmark(size, numThreads, numTimesteps, numPositionSpikes);
+        if(numThreads == 1) {
+            singleThreadStepTime = stepTime;
+            singleThreadSpikes = numPositionSpikes;
+        }
+
+        const double speedup = singleThreadStepTime / stepTime;
+        std::cout << numThreads << ", " << stepTime << ", " << speedup << ", " << speedup / (double)numThreads << ", "
+            << numPositionSpikes << std::endl;
+
+        // Partitioning changes the order inSyn contributions are summed in so activity can
+        // differ very slightly but it shouldn't differ by more than a handful of spikes
+        if(std::llabs((long long)numPositionSpikes - (long long)singleThreadSpikes) > (long long)(singleThreadSpikes / 1000)) {
+            std::cerr << "Partitioned activity diverged from single-threaded activity" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,10 @@
+#!/bin/bash
+# CPU simulator which doesn't require GeNN-generated code
+g++ simulator.cc -std=c++11 -O3 -march=native -o simulator
+g++ benchmark_layouts.cc -std=c++11 -O3 -march=native -o benchmark_layouts
+g++ benchmark_threads.cc -std=c++11 -O3 -march=native -pthread -o benchmark_threads
+g++ benchmark_active_set.cc -std=c++11 -O3 -march=native -o benchmark_active_set
+g++ generate_odometry.cc -std=c++11 -O3 -march=native -o generate_odometry
+g++ replay.cc -std=c++11 -O3 -march=native -o replay
+g++ benchmark_processes.cc -std=c++11 -O3 -march=native -o benchmark_processes
+g++ test_active_set.cc -std=c++11 -O3 -march=native -o test_active_set
@@ -0,0 +1,117 @@
+#pragma once
+
+// Standard C++ includes
+#include <stdexcept>
+#include <string>
+
+// Model includes
+#include "grid_halo.h"
+#include "grid_network.h"
+#include "halo_transport.h"
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// DistributedGridNetwork
+//----------------------------------------------------------------------------
+//! One rank's band of a world split between processes
+/*! Like PartitionedGridNetwork, the world is split into horizontal bands of rows, but each band
+    is simulated by a separate process so no memory is shared and worlds can be larger than a
+    single process can hold. Each rank constructs a DistributedGridNetwork with its own transport
+    and calls step() once per timestep. After its band is stepped, its boundary row halos are
+    exchanged with its neighbours through the transport and applied at the start of the next timestep.
+    As every rank only depends on its neighbours' previous timestep, results don't depend on scheduling. */
+template<typename Layout>
+class DistributedGridNetwork
+{
+public:
+    DistributedGridNetwork(unsigned int width, unsigned int height, HaloTransport &transport)
+    :   m_Transport(transport), m_RowBegin(calcRowBegin(height, transport.getRank(), transport.getNumRanks())),
+        m_RowEnd(calcRowBegin(height, transport.getRank() + 1, transport.getNumRanks())),
+        m_Network(width, m_RowEnd - m_RowBegin)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Advance this rank's band by one timestep
+    void step()
+    {
+        // Apply halos received at the end of the previous timestep
+        if(m_Transport.hasAbove()) {
+            applyGridHalo(m_Network, m_FromAbove, 0);
+        }
+        if(m_Transport.hasBelow()) {
+            applyGridHalo(m_Network, m_FromBelow, getNumRows() - 1);
+        }
+
+        m_Network.step();
+
+        // Exchange boundary row spikes with neighbours
+        extractGridHalos(m_Network, m_ToAbove, m_ToBelow);
+        m_Transport.exchange(m_ToAbove, m_ToBelow, m_FromAbove, m_FromBelow);
+    }
+
+    //! Set external current applied to position neuron at (x, y) if it is in this rank's band
+    void setPositionIExt(unsigned int x, unsigned int y, float current)
+    {
+        if(isInBand(y)) {
+            m_Network.getPosition().setIExt(m_Network.getLayout().getIndex(x, y - m_RowBegin), current);
+        }
+    }
+
+    //! Set external current applied to direction neuron (every rank has a replica)
+    void setDirectionIExt(Parameters::Direction direction, float current)
+    {
+        m_Network.setDirectionIExt(direction, current);
+    }
+
+    //! Call f with the world coordinates of each position neuron in this rank's band which spiked in the last timestep
+    template<typename F>
+    void forEachPositionSpike(F f)
+    {
+        const Layout &layout = m_Network.getLayout();
+        for(unsigned int i : m_Network.getPosition().getSpikes()) {
+            unsigned int x;
+            unsigned int y;
+            layout.getCoords(i, x, y);
+            f(x, m_RowBegin + y);
+        }
+    }
+
+    //! Number of position neurons in this rank's band which spiked in the last timestep
+    size_t getNumPositionSpikes(){ return m_Network.getPosition().getSpikes().size(); }
+
+    bool isInBand(unsigned int y) const{ return (y >= m_RowBegin && y < m_RowEnd); }
+    unsigned int getRowBegin() const{ return m_RowBegin; }
+    unsigned int getNumRows() const{ return m_RowEnd - m_RowBegin; }
+
+    GridNetwork<Layout> &getNetwork(){ return m_Network; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    //! Divide rows as evenly as possible between ranks
+    static unsigned int calcRowBegin(unsigned int height, unsigned int rank, unsigned int numRanks)
+    {
+        if(numRanks > height) {
+            throw std::runtime_error("Cannot split world of height " + std::to_string(height) + " between "
+                                     + std::to_string(numRanks) + " ranks");
+        }
+        return (unsigned int)(((unsigned long long)height * rank) / numRanks);
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    HaloTransport &m_Transport;
+    const unsigned int m_RowBegin;
+    const unsigned int m_RowEnd;
+    GridNetwork<Layout> m_Network;
+
+    GridHalo m_ToAbove;
+    GridHalo m_ToBelow;
+    GridHalo m_FromAbove;
+    GridHalo m_FromBelow;
+};
@@ -0,0 +1,38 @@
+// Standard C++ includes
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+// Standard C includes
+#include <cstdint>
+#include <cstdlib>
+
+// Model includes
+#include "odometry_log.h"
+#include "parameters.h"
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3) {
+        std::cerr << "Usage: generate_odometry <odometry log filename> <number of timesteps> [seed]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t numSteps = std::strtoull(argv[2], nullptr, 10);
+    const unsigned int seed = (argc > 3) ? std::atoi(argv[3]) : 1234;
+
+    // Random walk made up of segments where agent is either stationary or moving in a single direction
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<unsigned int> directionDist(0, Parameters::DirectionMax);
+    std::uniform_int_distribution<uint64_t> segmentLengthDist(50, 500);
+
+    OdometryLogWriter writer(argv[1]);
+    while(writer.getNumSteps() < numSteps) {
+        const unsigned int direction = directionDist(gen);
+        const uint8_t movement = (direction == Parameters::DirectionMax) ? 0 : OdometryLog::getMovementBit((Parameters::Direction)direction);
+        writer.write(movement, std::min(segmentLengthDist(gen), numSteps - writer.getNumSteps()));
+    }
+
+    std::cout << "Wrote " << numSteps << " timesteps of odometry to " << argv[1] << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// Standard C++ includes
+#include <vector>
+
+// Model includes
+#include "grid_network.h"
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// GridHalo
+//----------------------------------------------------------------------------
+//! Spikes in the first or last row of a band of the world which affect the neighbouring band
+/*! When a world is split into horizontal bands, the only projections which cross bands are the
+    vertical ones - lateral inhibition and the up and down interneurons. A band's first-row halo
+    therefore contains the x coordinates of position and up interneuron spikes in its first row and
+    its last-row halo contains those of position and down interneuron spikes in its last row. */
+struct GridHalo
+{
+    std::vector<unsigned int> positionSpikes;
+    std::vector<unsigned int> interneuronSpikes;
+
+    void clear()
+    {
+        positionSpikes.clear();
+        interneuronSpikes.clear();
+    }
+};
+
+//! Apply halo from neighbouring band to row of network (0 for the band above's last-row halo or
+//! the last row for the band below's first-row halo) - position spikes inhibit and interneuron spikes excite
+template<typename Layout>
+void applyGridHalo(GridNetwork<Layout> &network, const GridHalo &halo, unsigned int row)
+{
+    const Layout &layout = network.getLayout();
+    LIFPopulation &position = network.getPosition();
+    float *excitatoryInSyn = position.getInSyn(network.getPositionExcitatoryInput());
+    float *inhibitoryInSyn = position.getInSyn(network.getPositionInhibitoryInput());
+    const float lateralWeight = (float)Parameters::positionLateralWeight;
+    const float interneuronWeight = (float)Parameters::interneuronPositionWeight;
+
+    for(unsigned int x : halo.positionSpikes) {
+        const unsigned int j = layout.getIndex(x, row);
+        inhibitoryInSyn[j] += lateralWeight;
+        position.activate(j);
+    }
+    for(unsigned int x : halo.interneuronSpikes) {
+        const unsigned int j = layout.getIndex(x, row);
+        excitatoryInSyn[j] += interneuronWeight;
+        position.activate(j);
+    }
+}
+
+//! Copy spikes from the last timestep in network's first and last rows into halos
+template<typename Layout>
+void extractGridHalos(GridNetwork<Layout> &network, GridHalo &firstRow, GridHalo &lastRow)
+{
+    const Layout &layout = network.getLayout();
+    const unsigned int lastRowY = layout.getHeight() - 1;
+
+    firstRow.clear();
+    lastRow.clear();
+    for(unsigned int i : network.getPosition().getSpikes()) {
+        unsigned int x;
+        unsigned int y;
+        layout.getCoords(i, x, y);
+        if(y == 0) {
+            firstRow.positionSpikes.push_back(x);
+        }
+        if(y == lastRowY) {
+            lastRow.positionSpikes.push_back(x);
+        }
+    }
+
+    // Interneurons are laid out [cell][direction]
+    for(unsigned int i : network.getInterneuron().getSpikes()) {
+        const unsigned int direction = i % Parameters::DirectionMax;
+        unsigned int x;
+        unsigned int y;
+        layout.getCoords(i / Parameters::DirectionMax, x, y);
+        if(direction == Parameters::DirectionUp && y == 0) {
+            firstRow.interneuronSpikes.push_back(x);
+        }
+        else if(direction == Parameters::DirectionDown && y == lastRowY) {
+            lastRow.interneuronSpikes.push_back(x);
+        }
+    }
+}
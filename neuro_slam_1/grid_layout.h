@@ -0,0 +1,199 @@
+#pragma once
+
+// Standard C++ includes
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Standard C includes
+#include <cstdint>
+
+//----------------------------------------------------------------------------
+// RowMajorLayout
+//----------------------------------------------------------------------------
+//! Neurons are indexed (y * width) + x, as in the GeNN model. Horizontal neighbours
+//! are adjacent in memory but vertical neighbours are a whole row apart.
+class RowMajorLayout
+{
+public:
+    RowMajorLayout(unsigned int width, unsigned int height) : m_Width(width), m_Height(height)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    unsigned int getIndex(unsigned int x, unsigned int y) const
+    {
+        return (y * m_Width) + x;
+    }
+
+    void getCoords(unsigned int i, unsigned int &x, unsigned int &y) const
+    {
+        x = i % m_Width;
+        y = i / m_Width;
+    }
+
+    unsigned int getWidth() const{ return m_Width; }
+    unsigned int getHeight() const{ return m_Height; }
+
+    //! Size of populations using this layout
+    unsigned int getNumNeurons() const{ return m_Width * m_Height; }
+
+    static const char *getName(){ return "row-major"; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    unsigned int m_Width;
+    unsigned int m_Height;
+};
+
+//----------------------------------------------------------------------------
+// TiledLayout
+//----------------------------------------------------------------------------
+//! The grid is divided into square tiles of 2^TileBits neurons which are stored contiguously,
+//! row-major within each tile and tiles row-major across the grid
+/*! With the default 16x16 tiles, a tile of state variables fits in 1KB so most vertical neighbours
+    lie in the same few cache lines as horizontal ones. Populations are padded to a whole number of
+    tiles - padding neurons receive no input so never spike. */
+template<unsigned int TileBits = 4>
+class TiledLayout
+{
+public:
+    TiledLayout(unsigned int width, unsigned int height)
+    :   m_Width(width), m_Height(height), m_NumTilesX((unsigned int)(((uint64_t)width + tileSize - 1) / tileSize)),
+        m_NumTilesY((unsigned int)(((uint64_t)height + tileSize - 1) / tileSize))
+    {
+        // **NOTE** getCoords divides by the number of tiles and the number of
+        // neurons in the padded grid must fit in an unsigned int
+        if(width == 0 || height == 0) {
+            throw std::runtime_error("Tiled layout requires a world of at least one cell");
+        }
+        if((((uint64_t)m_NumTilesX * m_NumTilesY) << (2 * TileBits)) > std::numeric_limits<unsigned int>::max()) {
+            throw std::runtime_error("Tiled layout of " + std::to_string(width) + "x" + std::to_string(height)
+                                     + " cells has too many neurons once padded to whole tiles");
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    unsigned int getIndex(unsigned int x, unsigned int y) const
+    {
+        const unsigned int tile = ((y >> TileBits) * m_NumTilesX) + (x >> TileBits);
+        return (tile << (2 * TileBits)) | ((y & tileMask) << TileBits) | (x & tileMask);
+    }
+
+    void getCoords(unsigned int i, unsigned int &x, unsigned int &y) const
+    {
+        const unsigned int tile = i >> (2 * TileBits);
+        x = ((tile % m_NumTilesX) << TileBits) | (i & tileMask);
+        y = ((tile / m_NumTilesX) << TileBits) | ((i >> TileBits) & tileMask);
+    }
+
+    unsigned int getWidth() const{ return m_Width; }
+    unsigned int getHeight() const{ return m_Height; }
+    unsigned int getNumNeurons() const{ return (m_NumTilesX * m_NumTilesY) << (2 * TileBits); }
+
+    static const char *getName(){ return "tiled"; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr unsigned int tileSize = 1 << TileBits;
+    static constexpr unsigned int tileMask = tileSize - 1;
+
+    static_assert(TileBits > 0 && TileBits < 16, "Tiles must be between 2x2 and 32768x32768 neurons");
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    unsigned int m_Width;
+    unsigned int m_Height;
+    unsigned int m_NumTilesX;
+    unsigned int m_NumTilesY;
+};
+
+//----------------------------------------------------------------------------
+// MortonLayout
+//----------------------------------------------------------------------------
+//! Neurons are indexed along a Z-order curve by interleaving the bits of x and y
+/*! Locality is good at every scale but the grid must be padded to a power-of-two square,
+    which wastes a lot of neurons for worlds that aren't roughly square. */
+class MortonLayout
+{
+public:
+    MortonLayout(unsigned int width, unsigned int height) : m_Width(width), m_Height(height), m_Side(1)
+    {
+        // **NOTE** coordinates are interleaved from 16 bits but the number of
+        // neurons in a 65536 square would also overflow an unsigned int
+        if(width > maxSide || height > maxSide) {
+            throw std::runtime_error("Morton layout supports worlds of at most 32768x32768 cells");
+        }
+
+        while(m_Side < width || m_Side < height) {
+            m_Side *= 2;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    unsigned int getIndex(unsigned int x, unsigned int y) const
+    {
+        return spreadBits(x) | (spreadBits(y) << 1);
+    }
+
+    void getCoords(unsigned int i, unsigned int &x, unsigned int &y) const
+    {
+        x = compactBits(i);
+        y = compactBits(i >> 1);
+    }
+
+    unsigned int getWidth() const{ return m_Width; }
+    unsigned int getHeight() const{ return m_Height; }
+    unsigned int getNumNeurons() const{ return m_Side * m_Side; }
+
+    static const char *getName(){ return "morton"; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr unsigned int maxSide = 1u << 15;
+
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    //! Insert a zero bit above each of the lower 16 bits of v
+    static unsigned int spreadBits(uint32_t v)
+    {
+        v &= 0x0000FFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+
+    //! Inverse of spreadBits - gather even bits of v into lower 16 bits
+    static unsigned int compactBits(uint32_t v)
+    {
+        v &= 0x55555555;
+        v = (v | (v >> 1)) & 0x33333333;
+        v = (v | (v >> 2)) & 0x0F0F0F0F;
+        v = (v | (v >> 4)) & 0x00FF00FF;
+        v = (v | (v >> 8)) & 0x0000FFFF;
+        return v;
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    unsigned int m_Width;
+    unsigned int m_Height;
+    unsigned int m_Side;
+};
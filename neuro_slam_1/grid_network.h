@@ -0,0 +1,298 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Common includes
+#include "../common/connectivity_cache.h"
+
+// Model includes
+#include "grid_layout.h"
+#include "grid_stencil.h"
+#include "lif_population.h"
+#include "parameters.h"
+#include "projection.h"
+
+//----------------------------------------------------------------------------
+// GridNetwork
+//----------------------------------------------------------------------------
+//! CPU implementation of the network described in model.cc for a world of any size
+/*! GeNN can only represent the grid projections as ragged matrices whose memory grows with the
+    size of the world so, by default, they are implemented here as procedural grid stencils.
+    Passing procedural = false builds the same ragged matrices GeNN would for comparison and
+    activeSet = true only updates grid neurons which have recently received input. The four
+    direction interneuron populations are merged into one with state laid out [cell][direction]
+    so each position spike is delivered to a single block of four adjacent neurons.
+    Position and interneuron populations and all the projections between them index
+    neurons using Layout (see grid_layout.h). If a connectivityCacheFilename is passed, ragged
+    matrices are memory-mapped from it if it was built for the same world and layout or,
+    otherwise, built and written to it for next time. */
+template<typename Layout>
+class GridNetwork
+{
+public:
+    typedef GridStencil<Layout> Stencil;
+
+    GridNetwork(unsigned int width = Parameters::worldWidth, unsigned int height = Parameters::worldHeight,
+                bool procedural = true, bool activeSet = false, const std::string &connectivityCacheFilename = "")
+    :   m_Layout(width, height), m_Procedural(procedural), m_ConnectivityCached(false),
+        m_Position("Position", m_Layout.getNumNeurons(), getLIFParams(), Parameters::timestepMs, activeSet),
+        m_Direction("Direction", Parameters::DirectionMax, getLIFParams(), Parameters::timestepMs),
+        m_Wall("Wall", 1, getLIFParams(), Parameters::timestepMs),
+        m_Interneuron("Interneuron", m_Layout.getNumNeurons() * Parameters::DirectionMax, getLIFParams(),
+                      Parameters::timestepMs, activeSet, Parameters::DirectionMax)
+    {
+        // If ragged connectivity may be cached, try to load cache and, if it's stale, prepare to write a new one
+        if(!m_Procedural && !connectivityCacheFilename.empty()) {
+            const uint64_t key = getConnectivityKey(m_Layout);
+            m_ConnectivityCache.reset(new ConnectivityCache(connectivityCacheFilename, key));
+            m_ConnectivityCached = m_ConnectivityCache->isValid();
+            if(!m_ConnectivityCached) {
+                m_ConnectivityCacheWriter.reset(new ConnectivityCacheWriter(connectivityCacheFilename, key));
+            }
+        }
+
+        // Add inputs to position population
+        m_PositionExcitatory = m_Position.addInput(Parameters::tauSynExcitatory);
+        m_PositionInhibitory = m_Position.addInput(Parameters::tauSynInhibitory);
+
+        // Create recurrent excitation and lateral inhibition
+        if(m_Procedural) {
+            m_Projections.emplace_back(new IdentityProjection(m_Position, m_Position, m_PositionExcitatory,
+                                                              (float)Parameters::positionRecurrentWeight));
+        }
+        else {
+            addGridProjection("Position_Recurrent", m_Position, m_Position, m_PositionExcitatory,
+                              Parameters::positionRecurrentWeight, Stencil::identity(m_Layout));
+        }
+        addGridProjection("Position_Lateral", m_Position, m_Position, m_PositionInhibitory,
+                          Parameters::positionLateralWeight, Stencil::lateral(m_Layout));
+
+        // Add inputs to merged interneuron population
+        const unsigned int interneuronExcitatory = m_Interneuron.addInput(Parameters::tauSynExcitatory);
+        const unsigned int interneuronInhibitory = m_Interneuron.addInput(Parameters::tauSynInhibitory);
+
+        // Connect each position neuron to its interneuron for every direction
+        const unsigned int numDirections = Parameters::DirectionMax;
+        if(m_Procedural) {
+            m_Projections.emplace_back(new FanOutProjection(m_Position, m_Interneuron, interneuronExcitatory,
+                                                            (float)Parameters::positionInterneuronWeight, numDirections));
+        }
+        else {
+            addRaggedProjection("Position_Interneuron", m_Position, m_Interneuron, interneuronExcitatory,
+                                Parameters::positionInterneuronWeight, numDirections,
+                                [numDirections](unsigned int i, const RaggedProjection::AddSynapse &addSynapse)
+                                {
+                                    for(unsigned int d = 0; d < numDirections; d++) {
+                                        addSynapse((i * numDirections) + d);
+                                    }
+                                });
+        }
+
+        // Connect each interneuron to neighbouring position neuron in its direction
+        std::vector<Stencil> directionStencils;
+        for(unsigned int d = 0; d < numDirections; d++) {
+            directionStencils.push_back(Stencil::direction(m_Layout, (Parameters::Direction)d));
+        }
+        if(m_Procedural) {
+            m_Projections.emplace_back(new MultiStencilProjection<Layout>(m_Interneuron, m_Position, m_PositionExcitatory,
+                                                                          (float)Parameters::interneuronPositionWeight,
+                                                                          directionStencils));
+        }
+        else {
+            addRaggedProjection("Interneuron_Position", m_Interneuron, m_Position, m_PositionExcitatory,
+                                Parameters::interneuronPositionWeight, 1,
+                                [&directionStencils, numDirections](unsigned int i, const RaggedProjection::AddSynapse &addSynapse)
+                                {
+                                    directionStencils[i % numDirections].forEachTarget(i / numDirections, addSynapse);
+                                });
+        }
+
+        // Connect each direction inhibitory neuron to all interneurons of its direction
+        m_Projections.emplace_back(new BroadcastProjection(m_Direction, m_Interneuron, interneuronInhibitory,
+                                                           (float)Parameters::directionInterneuronWeight));
+
+        // Write any connectivity which was built to cache
+        if(m_ConnectivityCacheWriter) {
+            m_ConnectivityCacheWriter->write();
+            m_ConnectivityCacheWriter.reset();
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Advance network by one timestep - like GeNN, spikes from the previous
+    //! timestep are propagated before neurons are updated
+    void step()
+    {
+        for(auto &p : m_Projections) {
+            p->propagate();
+        }
+
+        m_Position.update();
+        m_Direction.update();
+        m_Wall.update();
+        m_Interneuron.update();
+    }
+
+    //! Set external current applied to direction neuron
+    void setDirectionIExt(Parameters::Direction direction, float current)
+    {
+        m_Direction.setIExt(direction, current);
+    }
+
+    //! Total number of neurons which will be updated next timestep
+    size_t getNumActive() const
+    {
+        return m_Position.getNumActive() + m_Direction.getNumActive() + m_Wall.getNumActive() + m_Interneuron.getNumActive();
+    }
+
+    //! Total memory used to store connectivity of all projections
+    size_t getConnectivityBytes() const
+    {
+        size_t bytes = 0;
+        for(const auto &p : m_Projections) {
+            bytes += p->getConnectivityBytes();
+        }
+        return bytes;
+    }
+
+    const Layout &getLayout() const{ return m_Layout; }
+    bool isProcedural() const{ return m_Procedural; }
+
+    //! Was ragged connectivity loaded from cache rather than built?
+    bool isConnectivityCached() const{ return m_ConnectivityCached; }
+
+    LIFPopulation &getPosition(){ return m_Position; }
+    LIFPopulation &getDirection(){ return m_Direction; }
+    LIFPopulation &getWall(){ return m_Wall; }
+
+    //! Interneurons for all directions, laid out [cell][direction]
+    LIFPopulation &getInterneuron(){ return m_Interneuron; }
+
+    //! Indices of position population's excitatory and inhibitory inputs
+    unsigned int getPositionExcitatoryInput() const{ return m_PositionExcitatory; }
+    unsigned int getPositionInhibitoryInput() const{ return m_PositionInhibitory; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    //! LIF model parameters shared by all populations
+    static LIFPopulation::Params getLIFParams()
+    {
+        return {1.0,        // C
+                20.0,       // TauM
+                -70.0,      // Vrest
+                -70.0,      // Vreset
+                -51.0,      // Vthresh
+                0.0,        // Ioffset
+                2.0};       // TauRefrac
+    }
+
+    //! Hash of everything ragged connectivity depends on
+    static uint64_t getConnectivityKey(const Layout &layout)
+    {
+        // **NOTE** bump whenever the way connectivity is built changes
+        const uint32_t version = 1;
+
+        // Different layouts can have the same name and size (e.g. TiledLayouts with different tile sizes)
+        // so also include the indices of a few cells to fingerprint the layout's mapping
+        const unsigned int maxX = layout.getWidth() - 1;
+        const unsigned int maxY = layout.getHeight() - 1;
+        return ConnectivityKey().add("neuro_slam_1").add(version).add(Layout::getName())
+            .add(layout.getWidth()).add(layout.getHeight()).add(layout.getNumNeurons())
+            .add(layout.getIndex(std::min(1u, maxX), 0)).add(layout.getIndex(0, std::min(1u, maxY)))
+            .add(layout.getIndex(maxX, maxY)).getHash();
+    }
+
+    //! Check ragged matrix loaded from cache can't index beyond its rows or the postsynaptic population
+    static bool isValidRagged(const unsigned int *rowLength, const unsigned int *ind, unsigned int numRows,
+                              unsigned int maxRowLength, unsigned int numPost)
+    {
+        for(unsigned int i = 0; i < numRows; i++) {
+            if(rowLength[i] > maxRowLength) {
+                return false;
+            }
+
+            const unsigned int *rowInd = &ind[(size_t)i * maxRowLength];
+            if(std::any_of(rowInd, rowInd + rowLength[i], [numPost](unsigned int j){ return (j >= numPost); })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void addGridProjection(const std::string &name, const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput,
+                           double weight, const Stencil &stencil)
+    {
+        if(m_Procedural) {
+            m_Projections.emplace_back(new StencilProjection<Layout>(pre, post, postInput, (float)weight, stencil));
+        }
+        else {
+            addRaggedProjection(name, pre, post, postInput, weight, stencil.getMaxRowLength(),
+                                [&stencil](unsigned int i, const RaggedProjection::AddSynapse &addSynapse)
+                                {
+                                    stencil.forEachTarget(i, addSynapse);
+                                });
+        }
+    }
+
+    //! Add ragged projection, mapping it from cache if possible or building it with buildRow if not
+    template<typename BuildRow>
+    void addRaggedProjection(const std::string &name, const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput,
+                             double weight, unsigned int maxRowLength, BuildRow buildRow)
+    {
+        if(m_ConnectivityCached) {
+            const unsigned int *rowLength = m_ConnectivityCache->getArray<unsigned int>(name + ".rowLength", pre.getSize());
+            const unsigned int *ind = m_ConnectivityCache->getArray<unsigned int>(name + ".ind", (size_t)pre.getSize() * maxRowLength);
+
+            // If cached connectivity is consistent with the populations, use it directly
+            if(isValidRagged(rowLength, ind, pre.getSize(), maxRowLength, post.getSize())) {
+                m_Projections.emplace_back(new RaggedProjection(pre, post, postInput, (float)weight, maxRowLength,
+                                                                rowLength, ind));
+                return;
+            }
+
+            // Otherwise, cache is corrupt so build this and all subsequent projections instead
+            // **NOTE** projections already mapped from the cache were validated in the same way
+            m_ConnectivityCached = false;
+        }
+
+        RaggedProjection *projection = new RaggedProjection(pre, post, postInput, (float)weight, maxRowLength, buildRow);
+        m_Projections.emplace_back(projection);
+
+        if(m_ConnectivityCacheWriter) {
+            m_ConnectivityCacheWriter->addArray(name + ".rowLength", projection->getRowLength(), projection->getNumRows());
+            m_ConnectivityCacheWriter->addArray(name + ".ind", projection->getInd(),
+                                                (size_t)projection->getNumRows() * projection->getMaxRowLength());
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const Layout m_Layout;
+    const bool m_Procedural;
+    bool m_ConnectivityCached;
+
+    LIFPopulation m_Position;
+    LIFPopulation m_Direction;
+    LIFPopulation m_Wall;
+    LIFPopulation m_Interneuron;
+    unsigned int m_PositionExcitatory;
+    unsigned int m_PositionInhibitory;
+
+    // Cache ragged projections are mapped from - must outlive them
+    std::unique_ptr<ConnectivityCache> m_ConnectivityCache;
+    std::unique_ptr<ConnectivityCacheWriter> m_ConnectivityCacheWriter;
+
+    std::vector<std::unique_ptr<Projection>> m_Projections;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+// Standard C++ includes
+#include <tuple>
+#include <vector>
+
+// Model includes
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// GridStencil
+//----------------------------------------------------------------------------
+//! Procedural connectivity between two populations laid out on the same grid
+/*! Each presynaptic neuron at (x, y) connects to the postsynaptic neurons at (x + dx, y + dy)
+    for every offset in the stencil which lands inside the grid. Targets are calculated on the fly
+    so, unlike a ragged matrix built by an InitSparseConnectivitySnippet, the only memory required
+    is the offset list - which doesn't grow with the size of the world. Layout maps between
+    neuron indices and grid coordinates (see grid_layout.h). */
+template<typename Layout>
+class GridStencil
+{
+public:
+    struct Offset
+    {
+        int x;
+        int y;
+    };
+
+    GridStencil(const Layout &layout, const std::vector<Offset> &offsets)
+    :   m_Layout(layout), m_Offsets(offsets)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    //! Connect each neuron to the neuron in the same position (equivalent to OneToOne)
+    static GridStencil identity(const Layout &layout)
+    {
+        return GridStencil(layout, {{0, 0}});
+    }
+
+    //! Connect each neuron to its neighbours in the cardinal directions (equivalent to LateralGrid)
+    static GridStencil lateral(const Layout &layout)
+    {
+        return GridStencil(layout, {{0, -1}, {0, 1}, {-1, 0}, {1, 0}});
+    }
+
+    //! Connect each neuron to its neighbour in one direction (equivalent to DirectionGrid)
+    static GridStencil direction(const Layout &layout, Parameters::Direction direction)
+    {
+        return GridStencil(layout, {{std::get<0>(Parameters::directionOffsets[direction]),
+                                     std::get<1>(Parameters::directionOffsets[direction])}});
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Call f with the index of each postsynaptic neuron presynaptic neuron i connects to
+    template<typename F>
+    void forEachTarget(unsigned int i, F f) const
+    {
+        unsigned int x;
+        unsigned int y;
+        m_Layout.getCoords(i, x, y);
+
+        // Padding neurons added by layout have no connections
+        if(x >= m_Layout.getWidth() || y >= m_Layout.getHeight()) {
+            return;
+        }
+
+        const int width = (int)m_Layout.getWidth();
+        const int height = (int)m_Layout.getHeight();
+        for(const auto &o : m_Offsets) {
+            const int xTarget = (int)x + o.x;
+            const int yTarget = (int)y + o.y;
+            if(xTarget >= 0 && xTarget < width && yTarget >= 0 && yTarget < height) {
+                f(m_Layout.getIndex((unsigned int)xTarget, (unsigned int)yTarget));
+            }
+        }
+    }
+
+    const Layout &getLayout() const{ return m_Layout; }
+
+    //! Maximum number of targets any presynaptic neuron can have
+    unsigned int getMaxRowLength() const{ return (unsigned int)m_Offsets.size(); }
+
+    //! Memory required to store connectivity
+    size_t getConnectivityBytes() const{ return sizeof(Offset) * m_Offsets.size(); }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    Layout m_Layout;
+    std::vector<Offset> m_Offsets;
+};
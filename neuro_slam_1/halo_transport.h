@@ -0,0 +1,372 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+// POSIX includes
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Model includes
+#include "grid_halo.h"
+#include "spin_barrier.h"
+
+//----------------------------------------------------------------------------
+// HaloTransport
+//----------------------------------------------------------------------------
+//! Interface used by each rank of a DistributedGridNetwork to exchange halos with its neighbours
+/*! Rank r's band lies directly below rank r - 1's and directly above rank r + 1's. Transport groups
+    are created before worker processes are forked and each worker then gets the transport for its rank. */
+class HaloTransport
+{
+public:
+    HaloTransport(unsigned int rank, unsigned int numRanks) : m_Rank(rank), m_NumRanks(numRanks)
+    {
+    }
+
+    virtual ~HaloTransport()
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Declared virtuals
+    //----------------------------------------------------------------------------
+    //! Send this timestep's halos to the neighbouring ranks and receive theirs. Every rank must
+    //! call this once per timestep and it doesn't return until the neighbours' halos have arrived
+    //! so it is also the per-timestep synchronisation point. Halos for neighbours which don't exist are ignored.
+    virtual void exchange(const GridHalo &toAbove, const GridHalo &toBelow, GridHalo &fromAbove, GridHalo &fromBelow) = 0;
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    unsigned int getRank() const{ return m_Rank; }
+    unsigned int getNumRanks() const{ return m_NumRanks; }
+
+    bool hasAbove() const{ return (m_Rank > 0); }
+    bool hasBelow() const{ return (m_Rank < (m_NumRanks - 1)); }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_Rank;
+    const unsigned int m_NumRanks;
+};
+
+//----------------------------------------------------------------------------
+// SharedMemoryHaloTransport
+//----------------------------------------------------------------------------
+//! Exchanges halos through an anonymous shared memory mapping inherited by forked workers
+/*! Each rank has a fixed-size slot for each of its halos, double buffered by timestep parity
+    like PartitionedGridNetwork's, so a single process-shared SpinBarrier per timestep is enough:
+    a rank can't overwrite a slot until every rank has passed the following timestep's barrier. */
+class SharedMemoryHaloTransport : public HaloTransport
+{
+public:
+    //----------------------------------------------------------------------------
+    // Group
+    //----------------------------------------------------------------------------
+    //! Shared state for all ranks - create before forking
+    class Group
+    {
+    public:
+        Group(unsigned int numRanks, unsigned int width)
+        :   m_NumRanks(numRanks), m_Width(width), m_SlotWords(2 + (2 * width)),
+            m_Size(sizeof(SpinBarrier) + (sizeof(uint32_t) * m_SlotWords * numRanks * 2 * 2))
+        {
+            m_Data = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if(m_Data == MAP_FAILED) {
+                throw std::runtime_error("Cannot create shared memory for halo transport");
+            }
+
+            // **NOTE** SpinBarrier only contains lock-free atomics so it works across processes
+            new (m_Data) SpinBarrier(numRanks);
+        }
+
+        ~Group()
+        {
+            getBarrier().~SpinBarrier();
+            munmap(m_Data, m_Size);
+        }
+
+        Group(const Group&) = delete;
+        Group &operator=(const Group&) = delete;
+
+        //! Get transport for rank - call in worker process
+        std::unique_ptr<HaloTransport> getTransport(unsigned int rank)
+        {
+            return std::unique_ptr<HaloTransport>(new SharedMemoryHaloTransport(*this, rank));
+        }
+
+        unsigned int getNumRanks() const{ return m_NumRanks; }
+        unsigned int getWidth() const{ return m_Width; }
+
+    private:
+        friend class SharedMemoryHaloTransport;
+
+        SpinBarrier &getBarrier(){ return *reinterpret_cast<SpinBarrier*>(m_Data); }
+
+        //! Get slot containing rank's first (row = 0) or last (row = 1) row halo for timestep parity
+        uint32_t *getSlot(unsigned int rank, unsigned int row, unsigned int parity)
+        {
+            uint32_t *slots = reinterpret_cast<uint32_t*>(reinterpret_cast<char*>(m_Data) + sizeof(SpinBarrier));
+            return &slots[((((rank * 2) + row) * 2) + parity) * m_SlotWords];
+        }
+
+        const unsigned int m_NumRanks;
+        const unsigned int m_Width;
+        const size_t m_SlotWords;
+        const size_t m_Size;
+        void *m_Data;
+    };
+
+    //----------------------------------------------------------------------------
+    // HaloTransport virtuals
+    //----------------------------------------------------------------------------
+    virtual void exchange(const GridHalo &toAbove, const GridHalo &toBelow, GridHalo &fromAbove, GridHalo &fromBelow) override
+    {
+        const unsigned int parity = m_Timestep % 2;
+
+        // Write our halos into our slots
+        writeSlot(toAbove, m_Group.getSlot(getRank(), 0, parity));
+        writeSlot(toBelow, m_Group.getSlot(getRank(), 1, parity));
+
+        // Wait for all ranks to write theirs
+        m_Group.getBarrier().wait();
+
+        // Read neighbours' halos - the last row of the rank above and the first row of the rank below
+        if(hasAbove()) {
+            readSlot(m_Group.getSlot(getRank() - 1, 1, parity), fromAbove);
+        }
+        if(hasBelow()) {
+            readSlot(m_Group.getSlot(getRank() + 1, 0, parity), fromBelow);
+        }
+        m_Timestep++;
+    }
+
+private:
+    SharedMemoryHaloTransport(Group &group, unsigned int rank)
+    :   HaloTransport(rank, group.getNumRanks()), m_Group(group), m_Timestep(0)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    //! Slots contain number of position spikes, number of interneuron spikes and then the spikes themselves
+    void writeSlot(const GridHalo &halo, uint32_t *slot) const
+    {
+        if(halo.positionSpikes.size() > m_Group.getWidth() || halo.interneuronSpikes.size() > m_Group.getWidth()) {
+            throw std::runtime_error("Halo larger than world width");
+        }
+        slot[0] = (uint32_t)halo.positionSpikes.size();
+        slot[1] = (uint32_t)halo.interneuronSpikes.size();
+        std::copy(halo.positionSpikes.cbegin(), halo.positionSpikes.cend(), &slot[2]);
+        std::copy(halo.interneuronSpikes.cbegin(), halo.interneuronSpikes.cend(), &slot[2 + slot[0]]);
+    }
+
+    void readSlot(const uint32_t *slot, GridHalo &halo) const
+    {
+        halo.positionSpikes.assign(&slot[2], &slot[2 + slot[0]]);
+        halo.interneuronSpikes.assign(&slot[2 + slot[0]], &slot[2 + slot[0] + slot[1]]);
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    Group &m_Group;
+    unsigned long long m_Timestep;
+};
+
+//----------------------------------------------------------------------------
+// SocketHaloTransport
+//----------------------------------------------------------------------------
+//! Exchanges halos over a pair of connected Unix domain sockets between each pair of neighbouring ranks
+/*! There is no global barrier - each rank only waits for its neighbours' halos - but, as a rank
+    can't advance until it has received them, execution is just as deterministic. So both ends of a
+    link are never blocked sending at once, the rank above always sends first and the rank below receives first. */
+class SocketHaloTransport : public HaloTransport
+{
+public:
+    //----------------------------------------------------------------------------
+    // Group
+    //----------------------------------------------------------------------------
+    //! Sockets linking all ranks - create before forking
+    class Group
+    {
+    public:
+        Group(unsigned int numRanks) : m_NumRanks(numRanks)
+        {
+            // Create a connected socket pair for the link between each rank and the rank below
+            for(unsigned int l = 0; (l + 1) < numRanks; l++) {
+                int fds[2];
+                if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+                    throw std::runtime_error("Cannot create socket pair for halo transport: " + std::string(strerror(errno)));
+                }
+                m_Links.push_back({fds[0], fds[1]});
+            }
+        }
+
+        ~Group()
+        {
+            for(auto &l : m_Links) {
+                closeLink(l);
+            }
+        }
+
+        Group(const Group&) = delete;
+        Group &operator=(const Group&) = delete;
+
+        //! Get transport for rank - call in worker process. Sockets not used
+        //! by rank are closed and the transport takes ownership of the rest
+        std::unique_ptr<HaloTransport> getTransport(unsigned int rank)
+        {
+            int aboveFD = -1;
+            int belowFD = -1;
+            for(unsigned int l = 0; l < m_Links.size(); l++) {
+                // Link l is between rank l (above) and rank l + 1 (below)
+                if(l == rank) {
+                    belowFD = m_Links[l].above;
+                    m_Links[l].above = -1;
+                }
+                else if((l + 1) == rank) {
+                    aboveFD = m_Links[l].below;
+                    m_Links[l].below = -1;
+                }
+                closeLink(m_Links[l]);
+            }
+            return std::unique_ptr<HaloTransport>(new SocketHaloTransport(rank, m_NumRanks, aboveFD, belowFD));
+        }
+
+    private:
+        //! Ends of link used by rank above and rank below
+        struct Link
+        {
+            int above;
+            int below;
+        };
+
+        static void closeLink(Link &link)
+        {
+            if(link.above != -1) {
+                close(link.above);
+                link.above = -1;
+            }
+            if(link.below != -1) {
+                close(link.below);
+                link.below = -1;
+            }
+        }
+
+        const unsigned int m_NumRanks;
+        std::vector<Link> m_Links;
+    };
+
+    virtual ~SocketHaloTransport()
+    {
+        if(m_AboveFD != -1) {
+            close(m_AboveFD);
+        }
+        if(m_BelowFD != -1) {
+            close(m_BelowFD);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // HaloTransport virtuals
+    //----------------------------------------------------------------------------
+    virtual void exchange(const GridHalo &toAbove, const GridHalo &toBelow, GridHalo &fromAbove, GridHalo &fromBelow) override
+    {
+        // We are below the rank above so receive first
+        if(hasAbove()) {
+            receive(m_AboveFD, fromAbove);
+            send(m_AboveFD, toAbove);
+        }
+
+        // We are above the rank below so send first
+        if(hasBelow()) {
+            send(m_BelowFD, toBelow);
+            receive(m_BelowFD, fromBelow);
+        }
+    }
+
+private:
+    SocketHaloTransport(unsigned int rank, unsigned int numRanks, int aboveFD, int belowFD)
+    :   HaloTransport(rank, numRanks), m_AboveFD(aboveFD), m_BelowFD(belowFD)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    //! Messages contain number of position spikes, number of interneuron spikes and then the spikes themselves
+    void send(int fd, const GridHalo &halo)
+    {
+        m_Buffer.clear();
+        m_Buffer.push_back((uint32_t)halo.positionSpikes.size());
+        m_Buffer.push_back((uint32_t)halo.interneuronSpikes.size());
+        m_Buffer.insert(m_Buffer.end(), halo.positionSpikes.cbegin(), halo.positionSpikes.cend());
+        m_Buffer.insert(m_Buffer.end(), halo.interneuronSpikes.cbegin(), halo.interneuronSpikes.cend());
+
+        const char *data = reinterpret_cast<const char*>(m_Buffer.data());
+        size_t remaining = sizeof(uint32_t) * m_Buffer.size();
+        while(remaining > 0) {
+            const ssize_t sent = ::send(fd, data, remaining, 0);
+            if(sent == -1) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Error sending halo: " + std::string(strerror(errno)));
+            }
+            data += sent;
+            remaining -= (size_t)sent;
+        }
+    }
+
+    void receive(int fd, GridHalo &halo)
+    {
+        uint32_t counts[2];
+        receiveAll(fd, counts, sizeof(counts));
+        halo.positionSpikes.resize(counts[0]);
+        halo.interneuronSpikes.resize(counts[1]);
+        receiveAll(fd, halo.positionSpikes.data(), sizeof(uint32_t) * counts[0]);
+        receiveAll(fd, halo.interneuronSpikes.data(), sizeof(uint32_t) * counts[1]);
+    }
+
+    static void receiveAll(int fd, void *buffer, size_t numBytes)
+    {
+        char *data = reinterpret_cast<char*>(buffer);
+        while(numBytes > 0) {
+            const ssize_t received = recv(fd, data, numBytes, 0);
+            if(received == 0) {
+                throw std::runtime_error("Neighbouring rank closed halo connection");
+            }
+            else if(received == -1) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("Error receiving halo: " + std::string(strerror(errno)));
+            }
+            data += received;
+            numBytes -= (size_t)received;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const int m_AboveFD;
+    const int m_BelowFD;
+    std::vector<uint32_t> m_Buffer;
+};
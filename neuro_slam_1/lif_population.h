@@ -0,0 +1,314 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+
+//----------------------------------------------------------------------------
+// LIFPopulation
+//----------------------------------------------------------------------------
+//! CPU implementation of a population of GeNN robotics LIF neurons with ExpCurr inputs
+/*! Each ExpCurr input has its own inSyn array so, as in GeNN, every synapse population
+    targetting this population can have a different synaptic time constant. Neurons are
+    interleaved between numChannels channels - neuron i belongs to channel i % numChannels -
+    and each input also has a global inSyn per channel, shared by all of its neurons, which
+    is used for broadcast projections.
+
+    In active-set mode, only neurons which have local input, external current or are refractory
+    are updated. All other neurons only receive global input so they follow the same linear
+    sub-threshold dynamics as their channel's background neuron, differing from it by an offset which
+    decays by ExpTC every timestep. When a neuron becomes quiescent, its offset from the background
+    neuron is stored and, when it next receives input, its membrane voltage is fast-forwarded in
+    closed form. Update cost therefore scales with the number of active neurons rather than the
+    size of the population. **NOTE** getV() is only up to date for active neurons. */
+class LIFPopulation
+{
+public:
+    struct Params
+    {
+        double c;           // Membrane capacitance (nF)
+        double tauM;        // Membrane time constant (ms)
+        double vRest;       // Resting membrane potential (mV)
+        double vReset;      // Reset voltage (mV)
+        double vThresh;     // Spiking threshold (mV)
+        double iOffset;     // Offset current (nA)
+        double tauRefrac;   // Refractory time (ms)
+    };
+
+    LIFPopulation(const std::string &name, unsigned int size, const Params &params, double dt, bool activeSet = false,
+                  unsigned int numChannels = 1)
+    :   m_Name(name), m_Size(size), m_NumChannels(numChannels), m_Params(params), m_DT((float)dt),
+        m_ExpTC((float)std::exp(-dt / params.tauM)), m_RMembrane((float)(params.tauM / params.c)),
+        m_V(size, (float)params.vRest), m_RefracTime(size, 0.0f), m_IExt(size, 0.0f), m_GlobalISyn(numChannels, 0.0f),
+        m_ActiveSet(activeSet), m_Timestep(0), m_VBackground(numChannels, (float)params.vRest),
+        m_NextVBackground(numChannels, (float)params.vRest), m_MaxInactiveOffset(0.0f)
+    {
+        if(numChannels == 0 || (size % numChannels) != 0) {
+            throw std::runtime_error("Population '" + name + "' size must be a multiple of its number of channels");
+        }
+        m_Spikes.reserve(size);
+
+        // In active-set mode, all neurons start inactive at rest
+        if(m_ActiveSet) {
+            m_Active.resize(size, 0);
+            m_Offset.resize(size, 0.0f);
+            m_LastUpdate.resize(size, 0);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Add an exponentially-decaying current input with time constant tauSyn, returning its index
+    unsigned int addInput(double tauSyn)
+    {
+        const double expDecay = std::exp(-m_DT / tauSyn);
+        m_Inputs.push_back({(float)expDecay, (float)((tauSyn * (1.0 - expDecay)) / m_DT),
+                            std::vector<float>(m_NumChannels, 0.0f), std::vector<float>(m_Size, 0.0f)});
+        return (unsigned int)(m_Inputs.size() - 1);
+    }
+
+    //! Advance neurons by one timestep
+    void update()
+    {
+        m_Spikes.clear();
+
+        // Sum each channel's global input and decay
+        std::fill(m_GlobalISyn.begin(), m_GlobalISyn.end(), 0.0f);
+        for(auto &input : m_Inputs) {
+            for(unsigned int c = 0; c < m_NumChannels; c++) {
+                m_GlobalISyn[c] += input.init * input.global[c];
+                input.global[c] *= input.expDecay;
+            }
+        }
+
+        if(m_ActiveSet) {
+            updateActive();
+        }
+        else {
+            for(unsigned int i = 0; i < m_Size; i += m_NumChannels) {
+                for(unsigned int c = 0; c < m_NumChannels; c++) {
+                    updateNeuron(i + c, m_GlobalISyn[c]);
+                }
+            }
+        }
+        m_Timestep++;
+    }
+
+    //! Mark neuron i as having received input - projections must call this after adding to inSyn
+    void activate(unsigned int i)
+    {
+        // **NOTE** this is called between updates so the background neurons have completed m_Timestep steps
+        if(m_ActiveSet && !m_Active[i]) {
+            wake(i, m_Timestep);
+        }
+    }
+
+    //! Add value to the global inSyn of input, shared by all neurons in channel
+    void addGlobalInSyn(unsigned int input, unsigned int channel, float value)
+    {
+        m_Inputs[input].global[channel] += value;
+    }
+
+    //! Set external current applied to neuron i (nA)
+    void setIExt(unsigned int i, float current)
+    {
+        m_IExt[i] = current;
+        activate(i);
+    }
+
+    //! Return population to its initial state
+    void reset()
+    {
+        std::fill(m_V.begin(), m_V.end(), (float)m_Params.vRest);
+        std::fill(m_RefracTime.begin(), m_RefracTime.end(), 0.0f);
+        std::fill(m_IExt.begin(), m_IExt.end(), 0.0f);
+        for(auto &input : m_Inputs) {
+            std::fill(input.global.begin(), input.global.end(), 0.0f);
+            std::fill(input.inSyn.begin(), input.inSyn.end(), 0.0f);
+        }
+        m_Spikes.clear();
+
+        m_Timestep = 0;
+        std::fill(m_VBackground.begin(), m_VBackground.end(), (float)m_Params.vRest);
+        m_MaxInactiveOffset = 0.0f;
+        std::fill(m_Active.begin(), m_Active.end(), 0);
+        std::fill(m_Offset.begin(), m_Offset.end(), 0.0f);
+        std::fill(m_LastUpdate.begin(), m_LastUpdate.end(), 0);
+        m_ActiveList.clear();
+    }
+
+    const std::string &getName() const{ return m_Name; }
+    unsigned int getSize() const{ return m_Size; }
+    unsigned int getNumChannels() const{ return m_NumChannels; }
+
+    float *getInSyn(unsigned int input){ return m_Inputs[input].inSyn.data(); }
+
+    const float *getIExt() const{ return m_IExt.data(); }
+
+    float *getV(){ return m_V.data(); }
+    float *getRefracTime(){ return m_RefracTime.data(); }
+
+    //! Indices of neurons which spiked in last call to update
+    const std::vector<unsigned int> &getSpikes() const{ return m_Spikes; }
+
+    bool isActiveSet() const{ return m_ActiveSet; }
+
+    //! Number of neurons which will be updated next timestep
+    unsigned int getNumActive() const{ return m_ActiveSet ? (unsigned int)m_ActiveList.size() : m_Size; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Input
+    //----------------------------------------------------------------------------
+    struct Input
+    {
+        float expDecay;
+        float init;
+        std::vector<float> global;
+        std::vector<float> inSyn;
+    };
+
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    //! Magnitude of inSyn below which neurons are considered quiescent and their inSyn zeroed
+    static constexpr float quiescentInSyn = 1.0E-4f;
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    //! Convert neuron i's input to current, decay it and integrate neuron
+    void updateNeuron(unsigned int i, float globalISyn)
+    {
+        float iSyn = m_IExt[i] + globalISyn;
+        for(auto &input : m_Inputs) {
+            iSyn += input.init * input.inSyn[i];
+            input.inSyn[i] *= input.expDecay;
+        }
+
+        if(m_RefracTime[i] <= 0.0f) {
+            const float alpha = ((iSyn + (float)m_Params.iOffset) * m_RMembrane) + (float)m_Params.vRest;
+            m_V[i] = alpha - (m_ExpTC * (alpha - m_V[i]));
+        }
+        else {
+            m_RefracTime[i] -= m_DT;
+        }
+
+        if(m_RefracTime[i] <= 0.0f && m_V[i] >= (float)m_Params.vThresh) {
+            m_V[i] = (float)m_Params.vReset;
+            m_RefracTime[i] = (float)m_Params.tauRefrac;
+            m_Spikes.push_back(i);
+        }
+    }
+
+    void updateActive()
+    {
+        // Calculate where background neurons which inactive neurons track will be after this timestep
+        float maxVBackground = -std::numeric_limits<float>::max();
+        for(unsigned int c = 0; c < m_NumChannels; c++) {
+            const float alpha = ((m_GlobalISyn[c] + (float)m_Params.iOffset) * m_RMembrane) + (float)m_Params.vRest;
+            m_NextVBackground[c] = alpha - (m_ExpTC * (alpha - m_VBackground[c]));
+            maxVBackground = std::max(maxVBackground, m_NextVBackground[c]);
+        }
+
+        // If global input could push an inactive neuron over threshold this timestep, wake everything
+        // **NOTE** neurons are woken before background neurons advance so they are integrated this timestep, as in dense mode
+        if(m_ActiveList.size() < m_Size && (maxVBackground + m_MaxInactiveOffset) >= (float)m_Params.vThresh) {
+            for(unsigned int i = 0; i < m_Size; i++) {
+                if(!m_Active[i]) {
+                    wake(i, m_Timestep);
+                }
+            }
+            m_MaxInactiveOffset = 0.0f;
+        }
+        m_VBackground.swap(m_NextVBackground);
+
+        // Update active neurons in index order so memory is accessed in order
+        std::sort(m_ActiveList.begin(), m_ActiveList.end());
+        auto nextActive = m_ActiveList.begin();
+        for(unsigned int i : m_ActiveList) {
+            const unsigned int c = i % m_NumChannels;
+            updateNeuron(i, m_GlobalISyn[c]);
+
+            // If neuron is still active, keep it in list
+            if(!isQuiescent(i)) {
+                *nextActive++ = i;
+            }
+            // Otherwise, zero its input and store its offset from background neuron
+            else {
+                for(auto &input : m_Inputs) {
+                    input.inSyn[i] = 0.0f;
+                }
+                m_Active[i] = 0;
+                m_Offset[i] = m_V[i] - m_VBackground[c];
+                m_LastUpdate[i] = m_Timestep + 1;
+                m_MaxInactiveOffset = std::max(m_MaxInactiveOffset, m_Offset[i]);
+            }
+        }
+        m_ActiveList.erase(nextActive, m_ActiveList.end());
+    }
+
+    bool isQuiescent(unsigned int i) const
+    {
+        if(m_RefracTime[i] > 0.0f || m_IExt[i] != 0.0f) {
+            return false;
+        }
+        for(const auto &input : m_Inputs) {
+            if(std::fabs(input.inSyn[i]) >= quiescentInSyn) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Fast-forward inactive neuron i to the current state of the background neurons, which have
+    //! completed numBackgroundSteps timesteps, and add it to the active list
+    void wake(unsigned int i, uint64_t numBackgroundSteps)
+    {
+        // Offset from background decays by ExpTC every background step since neuron was last updated
+        const uint64_t numSkipped = numBackgroundSteps - m_LastUpdate[i];
+        m_V[i] = m_VBackground[i % m_NumChannels] + (std::pow(m_ExpTC, (float)numSkipped) * m_Offset[i]);
+
+        m_Active[i] = 1;
+        m_ActiveList.push_back(i);
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const std::string m_Name;
+    const unsigned int m_Size;
+    const unsigned int m_NumChannels;
+    const Params m_Params;
+    const float m_DT;
+    const float m_ExpTC;
+    const float m_RMembrane;
+
+    std::vector<float> m_V;
+    std::vector<float> m_RefracTime;
+    std::vector<float> m_IExt;
+    std::vector<Input> m_Inputs;
+    std::vector<float> m_GlobalISyn;
+    std::vector<unsigned int> m_Spikes;
+
+    // Active-set state
+    const bool m_ActiveSet;
+    uint64_t m_Timestep;
+    std::vector<float> m_VBackground;
+    std::vector<float> m_NextVBackground;
+    float m_MaxInactiveOffset;
+    std::vector<uint8_t> m_Active;
+    std::vector<float> m_Offset;
+
+    //! Number of background steps completed when each inactive neuron's offset was stored
+    std::vector<uint64_t> m_LastUpdate;
+    std::vector<unsigned int> m_ActiveList;
+};
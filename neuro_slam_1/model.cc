@@ -25,15 +25,15 @@ public:
         "   $(addSynapse, $(i) - width);\n"
         "}\n"
         "// If presynaptic neuron isn't on last row\n"
-        "else if($(i) < ((width * height) - width)) {\n"
+        "if($(i) < ((width * height) - width)) {\n"
         "   $(addSynapse, $(i) + width);\n"
         "}\n"
         "// If presynaptic neuron isn't in first column\n"
-        "else if(($(i) % width) > 0) {\n"
+        "if(($(i) % width) > 0) {\n"
         "   $(addSynapse, $(i) - 1);\n"
         "}\n"
         "// If presynaptic neuron isn't in last column\n"
-        "else if(($(i) % width) < (width - 1)) {\n"
+        "if(($(i) % width) < (width - 1)) {\n"
         "   $(addSynapse, $(i) + 1);\n"
         "}\n"
         "$(endRow);\n");
@@ -42,33 +42,80 @@ public:
 };
 IMPLEMENT_SNIPPET(LateralGrid);
 
+//----------------------------------------------------------------------------
+// OneToDirections
+//----------------------------------------------------------------------------
+//! Initialises connectivity to connect each neuron to the block of interneurons
+//! (one per direction) in the same position in a [cell][direction] population
+class OneToDirections : public InitSparseConnectivitySnippet::Base
+{
+public:
+    DECLARE_SNIPPET(OneToDirections, 1);
+
+    SET_ROW_BUILD_CODE(
+        "const unsigned int numDirections = (unsigned int)$(numDirections);\n"
+        "for(unsigned int d = 0; d < numDirections; d++) {\n"
+        "   $(addSynapse, ($(i) * numDirections) + d);\n"
+        "}\n"
+        "$(endRow);\n");
+    
+    SET_PARAM_NAMES({"numDirections"});
+};
+IMPLEMENT_SNIPPET(OneToDirections);
+
 //----------------------------------------------------------------------------
 // DirectionGrid
 //----------------------------------------------------------------------------
-//! Initialises connectivity to connect each neuron to a neighbour with specific offset (if it's valid)
+//! Initialises connectivity to connect each interneuron in a [cell][direction] population
+//! to the neighbour of its cell in its direction (if it's valid)
+/*! **NOTE** offsets are passed in the order of Parameters::Direction */
 class DirectionGrid : public InitSparseConnectivitySnippet::Base
 {
 public:
-    DECLARE_SNIPPET(DirectionGrid, 4);
+    DECLARE_SNIPPET(DirectionGrid, 11);
 
     SET_ROW_BUILD_CODE(
         "const int width = (int)$(width);\n"
         "const int height = (int)$(height);\n"
-        "const int xTarget = ($(i) % width) + (int)$(xDir);\n"
-        "const int yTarget = ($(i) / width) + (int)$(yDir);\n"
+        "const int numDirections = (int)$(numDirections);\n"
+        "const int cell = $(i) / numDirections;\n"
+        "const int direction = $(i) % numDirections;\n"
+        "const int xDir = (direction == 0) ? (int)$(upX) : ((direction == 1) ? (int)$(downX) : ((direction == 2) ? (int)$(leftX) : (int)$(rightX)));\n"
+        "const int yDir = (direction == 0) ? (int)$(upY) : ((direction == 1) ? (int)$(downY) : ((direction == 2) ? (int)$(leftY) : (int)$(rightY)));\n"
+        "const int xTarget = (cell % width) + xDir;\n"
+        "const int yTarget = (cell / width) + yDir;\n"
         "if(xTarget >= 0 && xTarget < width && yTarget >= 0 && yTarget < height) {\n"
         "   $(addSynapse, (yTarget * width) + xTarget);\n"
         "}\n"
         "$(endRow);\n");
     
-    SET_PARAM_NAMES({"width", "height", "xDir", "yDir"});
+    SET_PARAM_NAMES({"width", "height", "numDirections", "upX", "upY", "downX", "downY", "leftX", "leftY", "rightX", "rightY"});
 };
 IMPLEMENT_SNIPPET(DirectionGrid);
 
+//----------------------------------------------------------------------------
+// DirectionRow
+//----------------------------------------------------------------------------
+//! Initialises connectivity to connect each direction neuron to all interneurons of that direction
+class DirectionRow : public InitSparseConnectivitySnippet::Base
+{
+public:
+    DECLARE_SNIPPET(DirectionRow, 1);
+
+    SET_ROW_BUILD_CODE(
+        "for(unsigned int j = $(i); j < $(num_post); j += (unsigned int)$(numDirections)) {\n"
+        "   $(addSynapse, j);\n"
+        "}\n"
+        "$(endRow);\n");
+    
+    SET_PARAM_NAMES({"numDirections"});
+};
+IMPLEMENT_SNIPPET(DirectionRow);
+
 void modelDefinition(NNmodel &model)
 {
     initGeNN();
-    model.setDT(1.0);
+    model.setDT(Parameters::timestepMs);
     model.setName("neuro_slam_1");
     
     // LIF model parameters
@@ -85,16 +132,16 @@ void modelDefinition(NNmodel &model)
     
      // Exponential current parameters
     ExpCurr::ParamValues excitatoryExpCurrParams(
-        5.0);  // 0 - TauSyn (ms)
+        Parameters::tauSynExcitatory);  // 0 - TauSyn (ms)
 
     ExpCurr::ParamValues inhibitoryExpCurrParams(
-        10.0);  // 0 - TauSyn (ms)
+        Parameters::tauSynInhibitory);  // 0 - TauSyn (ms)
         
     // Population where each neuron represents a position in the world
     model.addNeuronPopulation<LIF>("Position", Parameters::worldWidth * Parameters::worldHeight, lifParams, lifInit);
     
     // Create recurrent excitation
-    WeightUpdateModels::StaticPulse::VarValues positionRecurrentSynapseInit(8.0);
+    WeightUpdateModels::StaticPulse::VarValues positionRecurrentSynapseInit(Parameters::positionRecurrentWeight);
     model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
         "Position_Recurrent", SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
         "Position", "Position",
@@ -104,7 +151,7 @@ void modelDefinition(NNmodel &model)
     
     // Create lateral inhibition
     LateralGrid::ParamValues lateralGridParams(Parameters::worldWidth, Parameters::worldHeight);
-    WeightUpdateModels::StaticPulse::VarValues positionLateralSynapseInit(-8.0);
+    WeightUpdateModels::StaticPulse::VarValues positionLateralSynapseInit(Parameters::positionLateralWeight);
     model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
         "Position_Lateral", SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
         "Position", "Position",
@@ -113,48 +160,53 @@ void modelDefinition(NNmodel &model)
         initConnectivity<LateralGrid>(lateralGridParams));
     
     // Population where each (inhibitory) neuron represents a movement direction component
-    auto *direction = model.addNeuronPopulation<LIF>("Direction", Parameters::DirectionMax, lifParams, lifInit);
+    model.addNeuronPopulation<LIF>("Direction", Parameters::DirectionMax, lifParams, lifInit);
     
     // Create wall population
-    auto *wall = model.addNeuronPopulation<LIF>("Wall", 1, lifParams, lifInit);*/
-    
-    // Loop through directions
-    WeightUpdateModels::StaticPulse::VarValues positionDirectionSynapseInit(8.0);
-    WeightUpdateModels::StaticPulse::VarValues directionPositionSynapseInit(8.0);
-    WeightUpdateModels::StaticPulse::VarValues directionPositionSynapseInit(8.0);
-    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
-        // Population of interneurons to connect neighbours
-        // **NOTE** these populations are one neuron in one dimension oversized to simplify indexing
-        const std::string name = std::string("Interneuron") + std::string(Parameters::directionNames[d]);
-        model.addNeuronPopulation<LIF>(name, Parameters::worldWidth * Parameters::worldHeight, lifParams, lifInit);
-        
-        // Connect each position neuron to corresponding direction interneuron
-        model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
-            "Position_" + name, SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
-            "Position", name,
-            {}, positionDirectionSynapseInit,
-            excitatoryExpCurrParams, {},
-            initConnectivity<InitSparseConnectivitySnippet::OneToOne>({}));
-        
-        // Connect each interneuron to neighbouring  position neuron with correct offset
-        /*DirectionGrid::ParamValues directionGridParams(Parameters::worldWidth, 
-                                                       Parameters::worldHeight, 
-                                                       std::get<0>(Parameters::directionOffsets[d]),
-                                                       std::get<1>(Parameters::directionOffsets[d]));
-        model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
-            name + "_Position", SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
-            name, "Position", 
-            {}, directionPositionSynapseInit,
-            excitatoryExpCurrParams, {},
-            initConnectivity<DirectionGrid>(directionGridParams));
-        
-        // Connect direction inhibitory neurons to all interneurons
-        model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
-            name + "_Position", SynapseMatrixType::DENSE_GLOBALG, NO_DELAY,
-            name, "Position", 
-            {}, directionPositionSynapseInit,
-            excitatoryExpCurrParams, {});*/
-    }
+    model.addNeuronPopulation<LIF>("Wall", 1, lifParams, lifInit);
+    
+    // Population of interneurons to connect neighbours with one neuron per direction in each cell
+    // **NOTE** state is laid out [cell][direction] so each position spike touches one block of interneurons
+    model.addNeuronPopulation<LIF>("Interneuron", Parameters::worldWidth * Parameters::worldHeight * Parameters::DirectionMax, 
+                                   lifParams, lifInit);
+    
+    // Connect each position neuron to its interneuron for every direction
+    WeightUpdateModels::StaticPulse::VarValues positionInterneuronSynapseInit(Parameters::positionInterneuronWeight);
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
+        "Position_Interneuron", SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
+        "Position", "Interneuron",
+        {}, positionInterneuronSynapseInit,
+        excitatoryExpCurrParams, {},
+        initConnectivity<OneToDirections>(OneToDirections::ParamValues(Parameters::DirectionMax)));
+    
+    // Connect each interneuron to neighbouring position neuron in its direction
+    // **NOTE** offsets come from the same table as the CPU backend's direction stencils
+    static_assert(Parameters::DirectionMax == 4, "DirectionGrid has offset parameters for exactly four directions");
+    DirectionGrid::ParamValues directionGridParams(Parameters::worldWidth, Parameters::worldHeight, Parameters::DirectionMax,
+                                                   std::get<0>(Parameters::directionOffsets[Parameters::DirectionUp]),
+                                                   std::get<1>(Parameters::directionOffsets[Parameters::DirectionUp]),
+                                                   std::get<0>(Parameters::directionOffsets[Parameters::DirectionDown]),
+                                                   std::get<1>(Parameters::directionOffsets[Parameters::DirectionDown]),
+                                                   std::get<0>(Parameters::directionOffsets[Parameters::DirectionLeft]),
+                                                   std::get<1>(Parameters::directionOffsets[Parameters::DirectionLeft]),
+                                                   std::get<0>(Parameters::directionOffsets[Parameters::DirectionRight]),
+                                                   std::get<1>(Parameters::directionOffsets[Parameters::DirectionRight]));
+    WeightUpdateModels::StaticPulse::VarValues interneuronPositionSynapseInit(Parameters::interneuronPositionWeight);
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
+        "Interneuron_Position", SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
+        "Interneuron", "Position", 
+        {}, interneuronPositionSynapseInit,
+        excitatoryExpCurrParams, {},
+        initConnectivity<DirectionGrid>(directionGridParams));
+    
+    // Connect each direction inhibitory neuron to all interneurons of its direction
+    WeightUpdateModels::StaticPulse::VarValues directionInterneuronSynapseInit(Parameters::directionInterneuronWeight);
+    model.addSynapsePopulation<WeightUpdateModels::StaticPulse, ExpCurr>(
+        "Direction_Interneuron", SynapseMatrixType::RAGGED_GLOBALG, NO_DELAY,
+        "Direction", "Interneuron", 
+        {}, directionInterneuronSynapseInit,
+        inhibitoryExpCurrParams, {},
+        initConnectivity<DirectionRow>(DirectionRow::ParamValues(Parameters::DirectionMax)));
     
     // Create synape populations
     model.finalize();
@@ -0,0 +1,65 @@
+#pragma once
+
+// Standard C includes
+#include <cstdint>
+
+// Model includes
+#include "odometry_log.h"
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// OdometryDriver
+//----------------------------------------------------------------------------
+//! Replays an odometry log into a network's direction populations
+/*! Each direction neuron inhibits the interneurons which shift the bump in its direction so,
+    when the agent is stationary, all direction neurons are driven with current. Moving in a
+    direction is signalled by releasing that direction's neuron so its interneurons are
+    disinhibited. Currents are only set when the movement changes so replaying a log
+    typically costs a single byte read per timestep. Network can be a GridNetwork or a
+    PartitionedGridNetwork - anything with a setDirectionIExt(direction, current) method. */
+class OdometryDriver
+{
+public:
+    OdometryDriver(const OdometryLog &log, float current) : m_Log(log), m_Current(current), m_Step(0), m_Movement(0)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Apply the next timestep's movement to network - returns false at the end of the log
+    template<typename Network>
+    bool apply(Network &network)
+    {
+        if(m_Step >= m_Log.getNumSteps()) {
+            return false;
+        }
+
+        // If this is the first step or movement has changed, update currents
+        const uint8_t movement = m_Log.getMovement(m_Step);
+        if(m_Step == 0 || movement != m_Movement) {
+            for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+                const bool moving = (movement & OdometryLog::getMovementBit((Parameters::Direction)d)) != 0;
+                network.setDirectionIExt((Parameters::Direction)d, moving ? 0.0f : m_Current);
+            }
+            m_Movement = movement;
+        }
+
+        m_Step++;
+        return true;
+    }
+
+    //! Restart replay from the first timestep
+    void rewind(){ m_Step = 0; }
+
+    uint64_t getStep() const{ return m_Step; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const OdometryLog &m_Log;
+    const float m_Current;
+    uint64_t m_Step;
+    uint8_t m_Movement;
+};
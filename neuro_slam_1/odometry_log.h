@@ -0,0 +1,204 @@
+#pragma once
+
+// Standard C++ includes
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstring>
+
+// POSIX includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Model includes
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// OdometryLogHeader
+//----------------------------------------------------------------------------
+//! Header at the start of odometry log files. It is followed by one movement byte per
+//! timestep with bit d set if the agent is moving in Parameters::Direction d
+struct OdometryLogHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t padding;
+    uint64_t numSteps;
+
+    static constexpr const char *magicString = "NSODOMET";
+    static constexpr uint32_t currentVersion = 1;
+};
+
+//----------------------------------------------------------------------------
+// OdometryLogWriter
+//----------------------------------------------------------------------------
+//! Streams movements into an odometry log file
+class OdometryLogWriter
+{
+public:
+    OdometryLogWriter(const std::string &filename) : m_Stream(filename, std::ios::binary), m_NumSteps(0)
+    {
+        if(!m_Stream.good()) {
+            throw std::runtime_error("Cannot open odometry log '" + filename + "' for writing");
+        }
+
+        // Write header - number of steps is filled in when writer is destroyed
+        writeHeader();
+    }
+
+    ~OdometryLogWriter()
+    {
+        // Rewind and update header with final step count
+        m_Stream.seekp(0);
+        writeHeader();
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Append numSteps timesteps of the same movement
+    void write(uint8_t movement, uint64_t numSteps = 1)
+    {
+        for(uint64_t s = 0; s < numSteps; s++) {
+            m_Stream.put((char)movement);
+        }
+        if(!m_Stream.good()) {
+            throw std::runtime_error("Error writing odometry log");
+        }
+        m_NumSteps += numSteps;
+    }
+
+    uint64_t getNumSteps() const{ return m_NumSteps; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void writeHeader()
+    {
+        OdometryLogHeader header;
+        memcpy(header.magic, OdometryLogHeader::magicString, sizeof(header.magic));
+        header.version = OdometryLogHeader::currentVersion;
+        header.padding = 0;
+        header.numSteps = m_NumSteps;
+        m_Stream.write(reinterpret_cast<const char*>(&header), sizeof(OdometryLogHeader));
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    std::ofstream m_Stream;
+    uint64_t m_NumSteps;
+};
+
+//----------------------------------------------------------------------------
+// OdometryLog
+//----------------------------------------------------------------------------
+//! Read-only view of an odometry log file
+/*! By default the file is memory-mapped so it is paged in by the OS as it is replayed
+    but, if preload is set, it is read into memory up front so replay never waits on IO. */
+class OdometryLog
+{
+public:
+    OdometryLog(const std::string &filename, bool preload = false) : m_Data(nullptr), m_Size(0), m_NumSteps(0), m_Movements(nullptr)
+    {
+        // Open file and get its size
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if(fd == -1) {
+            throw std::runtime_error("Cannot open odometry log '" + filename + "'");
+        }
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == -1) {
+            close(fd);
+            throw std::runtime_error("Cannot stat odometry log '" + filename + "'");
+        }
+        m_Size = (size_t)fileStat.st_size;
+        if(m_Size < sizeof(OdometryLogHeader)) {
+            close(fd);
+            throw std::runtime_error("Odometry log '" + filename + "' is too small to contain header");
+        }
+
+        // Map file - the mapping remains valid after the file descriptor is closed
+        m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(m_Data == MAP_FAILED) {
+            m_Data = nullptr;
+            throw std::runtime_error("Cannot memory map odometry log '" + filename + "'");
+        }
+
+        // Validate header
+        const OdometryLogHeader *header = reinterpret_cast<const OdometryLogHeader*>(m_Data);
+        if(memcmp(header->magic, OdometryLogHeader::magicString, sizeof(header->magic)) != 0
+            || header->version != OdometryLogHeader::currentVersion)
+        {
+            unmap();
+            throw std::runtime_error("'" + filename + "' is not a compatible odometry log");
+        }
+        m_NumSteps = header->numSteps;
+        // **NOTE** compare against space after header so corrupt step counts can't overflow
+        if(m_NumSteps > (m_Size - sizeof(OdometryLogHeader))) {
+            unmap();
+            throw std::runtime_error("Odometry log '" + filename + "' is truncated");
+        }
+
+        // If log should be preloaded, copy movements and unmap file
+        if(preload) {
+            const uint8_t *movements = reinterpret_cast<const uint8_t*>(header + 1);
+            m_Preloaded.assign(movements, movements + m_NumSteps);
+            m_Movements = m_Preloaded.data();
+            unmap();
+        }
+        else {
+            m_Movements = reinterpret_cast<const uint8_t*>(header + 1);
+        }
+    }
+
+    ~OdometryLog()
+    {
+        unmap();
+    }
+
+    OdometryLog(const OdometryLog&) = delete;
+    OdometryLog &operator=(const OdometryLog&) = delete;
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Get movement at timestep - bit d is set if agent is moving in direction d
+    uint8_t getMovement(uint64_t step) const{ return m_Movements[step]; }
+
+    uint64_t getNumSteps() const{ return m_NumSteps; }
+    bool isPreloaded() const{ return (m_Data == nullptr); }
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    static uint8_t getMovementBit(Parameters::Direction direction){ return (uint8_t)(1 << direction); }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void unmap()
+    {
+        if(m_Data != nullptr) {
+            munmap(m_Data, m_Size);
+            m_Data = nullptr;
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    void *m_Data;
+    size_t m_Size;
+    uint64_t m_NumSteps;
+    const uint8_t *m_Movements;
+    std::vector<uint8_t> m_Preloaded;
+};
@@ -15,7 +15,7 @@ namespace Parameters
         DirectionMax
     };
     
-    const char *directionNames[DirectionMax] = 
+    const char *const directionNames[DirectionMax] = 
     {
         "Up",
         "Down",
@@ -27,14 +27,34 @@ namespace Parameters
     {
         std::make_tuple(0, -1),
         std::make_tuple(0, 1),
-        std::make_tuple(0, -1),
-        std::make_tuple(0, 1),
+        std::make_tuple(-1, 0),
+        std::make_tuple(1, 0),
     };
     
     // How big is the world?
     const unsigned int worldWidth = 10;
     const unsigned int worldHeight = 10;
     
+    // Simulation timestep (ms)
+    const double timestepMs = 1.0;
+    
+    // Synaptic time constants (ms)
+    const double tauSynExcitatory = 5.0;
+    const double tauSynInhibitory = 10.0;
+    
+    // Synaptic weights
+    const double positionRecurrentWeight = 8.0;
+    const double positionLateralWeight = -8.0;
+    const double positionInterneuronWeight = 8.0;
+    const double interneuronPositionWeight = 8.0;
+    const double directionInterneuronWeight = -8.0;
+    
+    // Time constant of filter used to decode position from position spikes (ms)
+    const double decoderTauMs = 20.0;
+    
+    // Spread of a single bump of activity used to calculate decoder confidence (cells)
+    const double decoderExpectedSpread = 1.0;
+    
     inline unsigned int getNeuronIndex(unsigned int x, unsigned int y)
     {
         return (y * worldWidth) + x;
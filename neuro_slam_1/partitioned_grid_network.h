@@ -0,0 +1,192 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Model includes
+#include "grid_halo.h"
+#include "grid_network.h"
+#include "parameters.h"
+#include "spin_barrier.h"
+
+//----------------------------------------------------------------------------
+// PartitionedGridNetwork
+//----------------------------------------------------------------------------
+//! Multithreaded version of GridNetwork where the world is split into horizontal bands of rows
+/*! Each band is a complete GridNetwork, owned and stepped by one thread, so its neuron state and
+    spike buffers are only ever touched by that thread. The only projections which cross bands
+    are the vertical ones so, after each timestep, every band copies the spikes in its first and
+    last rows into halos (see grid_halo.h) which its neighbours apply at the start of the next
+    timestep. Halos are double buffered by timestep parity so a single barrier per timestep is
+    enough. The 4 neuron direction population is replicated in every band - as replicas receive
+    identical input, they stay in sync. */
+template<typename Layout>
+class PartitionedGridNetwork
+{
+public:
+    PartitionedGridNetwork(unsigned int width, unsigned int height, unsigned int numThreads)
+    :   m_Width(width), m_Height(height), m_NumThreads(std::max(1u, std::min(numThreads, height))),
+        m_StartBarrier(m_NumThreads), m_EndBarrier(m_NumThreads), m_Stop(false), m_Timestep(0)
+    {
+        // Divide rows as evenly as possible between partitions
+        for(unsigned int p = 0; p < m_NumThreads; p++) {
+            const unsigned int rowBegin = (height * p) / m_NumThreads;
+            const unsigned int rowEnd = (height * (p + 1)) / m_NumThreads;
+            m_Partitions.emplace_back(new Partition(width, rowBegin, rowEnd));
+        }
+
+        // Start worker threads - the thread calling step() steps partition 0
+        for(unsigned int p = 1; p < m_NumThreads; p++) {
+            m_Workers.emplace_back(&PartitionedGridNetwork::workerThread, this, p);
+        }
+    }
+
+    ~PartitionedGridNetwork()
+    {
+        // Release workers from start barrier with stop flag set
+        m_Stop = true;
+        m_StartBarrier.wait();
+        for(auto &w : m_Workers) {
+            w.join();
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Advance all partitions by one timestep
+    void step()
+    {
+        m_StartBarrier.wait();
+        stepPartition(0);
+        m_EndBarrier.wait();
+        m_Timestep++;
+    }
+
+    //! Set external current applied to position neuron at (x, y)
+    void setPositionIExt(unsigned int x, unsigned int y, float current)
+    {
+        Partition &partition = getPartitionForRow(y);
+        const unsigned int i = partition.network.getLayout().getIndex(x, y - partition.rowBegin);
+        partition.network.getPosition().setIExt(i, current);
+    }
+
+    //! Set external current applied to direction neuron (in every partition)
+    void setDirectionIExt(Parameters::Direction direction, float current)
+    {
+        for(auto &p : m_Partitions) {
+            p->network.getDirection().setIExt(direction, current);
+        }
+    }
+
+    //! Call f with the world coordinates of each position neuron which spiked in the last timestep
+    template<typename F>
+    void forEachPositionSpike(F f) const
+    {
+        for(const auto &p : m_Partitions) {
+            const Layout &layout = p->network.getLayout();
+            for(unsigned int i : p->network.getPosition().getSpikes()) {
+                unsigned int x;
+                unsigned int y;
+                layout.getCoords(i, x, y);
+                f(x, p->rowBegin + y);
+            }
+        }
+    }
+
+    //! Total number of position neurons which spiked in the last timestep
+    size_t getNumPositionSpikes() const
+    {
+        size_t numSpikes = 0;
+        for(const auto &p : m_Partitions) {
+            numSpikes += p->network.getPosition().getSpikes().size();
+        }
+        return numSpikes;
+    }
+
+    unsigned int getWidth() const{ return m_Width; }
+    unsigned int getHeight() const{ return m_Height; }
+    unsigned int getNumThreads() const{ return m_NumThreads; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Partition
+    //----------------------------------------------------------------------------
+    struct Partition
+    {
+        Partition(unsigned int width, unsigned int begin, unsigned int end)
+        :   rowBegin(begin), numRows(end - begin), network(width, end - begin)
+        {
+        }
+
+        const unsigned int rowBegin;
+        const unsigned int numRows;
+        GridNetwork<Layout> network;
+
+        // Halos containing boundary row spikes, indexed by timestep parity
+        GridHalo firstRowHalo[2];
+        GridHalo lastRowHalo[2];
+    };
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    Partition &getPartitionForRow(unsigned int y)
+    {
+        const auto p = std::upper_bound(m_Partitions.cbegin(), m_Partitions.cend(), y,
+                                        [](unsigned int y, const std::unique_ptr<Partition> &p){ return y < p->rowBegin; });
+        return **std::prev(p);
+    }
+
+    void workerThread(unsigned int p)
+    {
+        while(true) {
+            m_StartBarrier.wait();
+            if(m_Stop) {
+                return;
+            }
+            stepPartition(p);
+            m_EndBarrier.wait();
+        }
+    }
+
+    void stepPartition(unsigned int p)
+    {
+        Partition &partition = *m_Partitions[p];
+        const unsigned int write = m_Timestep % 2;
+        const unsigned int read = 1 - write;
+
+        // Apply halo spikes from last row of partition above to our first row
+        if(p > 0) {
+            applyGridHalo(partition.network, m_Partitions[p - 1]->lastRowHalo[read], 0);
+        }
+
+        // Apply halo spikes from first row of partition below to our last row
+        if(p < (m_NumThreads - 1)) {
+            applyGridHalo(partition.network, m_Partitions[p + 1]->firstRowHalo[read], partition.numRows - 1);
+        }
+
+        partition.network.step();
+
+        // Copy boundary row spikes into halos
+        extractGridHalos(partition.network, partition.firstRowHalo[write], partition.lastRowHalo[write]);
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_Width;
+    const unsigned int m_Height;
+    const unsigned int m_NumThreads;
+
+    std::vector<std::unique_ptr<Partition>> m_Partitions;
+    std::vector<std::thread> m_Workers;
+
+    SpinBarrier m_StartBarrier;
+    SpinBarrier m_EndBarrier;
+    bool m_Stop;
+    unsigned long long m_Timestep;
+};
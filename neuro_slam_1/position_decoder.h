@@ -0,0 +1,155 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+
+//----------------------------------------------------------------------------
+// PositionDecoder
+//----------------------------------------------------------------------------
+//! Incrementally decodes the position of the bump of activity in the position population
+/*! Each spike is weighted by how long ago it occurred using an exponential filter with
+    time constant tau so, rather than storing spikes, only the filtered spike count and the
+    filtered sums of spike coordinates and their squares need to be maintained. Each timestep
+    therefore costs O(1) plus O(1) per spike. From these sums, the bump's centroid and its
+    spread (RMS distance of spikes from the centroid) can be read out at any time.
+
+    Confidence combines how much activity has been seen recently with how compact it is:
+    it approaches 1 when many spikes have been filtered and they are spread over no more than
+    expectedSpread cells and falls towards 0 if the network is silent or activity is diffuse
+    e.g. if there are multiple bumps. **NOTE** the world doesn't wrap so coordinates are averaged linearly. */
+class PositionDecoder
+{
+public:
+    PositionDecoder(double tau, double dt, double expectedSpread = 1.0)
+    :   m_Decay(std::exp(-dt / tau)), m_ExpectedVariance(expectedSpread * expectedSpread)
+    {
+        reset();
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Decay filtered sums by one timestep - call once per timestep before adding that timestep's spikes
+    void decay()
+    {
+        // Once past activity is negligible, forget it entirely so the next spike re-anchors the origin
+        // **NOTE** the sums only reach exactly zero after decaying through the denormals for thousands of timesteps
+        if((m_SumWeight * m_Decay) < minWeight) {
+            reset();
+        }
+        else {
+            m_SumWeight *= m_Decay;
+            m_SumX *= m_Decay;
+            m_SumY *= m_Decay;
+            m_SumSquared *= m_Decay;
+        }
+    }
+
+    //! Add a spike from the position neuron at (x, y)
+    void addSpike(unsigned int x, unsigned int y)
+    {
+        // Coordinates are accumulated relative to the first spike since the decoder was last
+        // reset so, in large worlds, variance isn't lost in rounding error when the squared
+        // centroid is subtracted
+        if(m_SumWeight == 0.0) {
+            m_OriginX = x;
+            m_OriginY = y;
+        }
+
+        const double dx = (double)x - m_OriginX;
+        const double dy = (double)y - m_OriginY;
+        m_SumWeight += 1.0;
+        m_SumX += dx;
+        m_SumY += dy;
+        m_SumSquared += (dx * dx) + (dy * dy);
+    }
+
+    //! Decay and add one timestep's spikes, given as indices into layout
+    template<typename Layout>
+    void update(const Layout &layout, const std::vector<unsigned int> &spikes)
+    {
+        decay();
+        for(unsigned int i : spikes) {
+            unsigned int x;
+            unsigned int y;
+            layout.getCoords(i, x, y);
+            addSpike(x, y);
+        }
+    }
+
+    void reset()
+    {
+        m_SumWeight = 0.0;
+        m_SumX = 0.0;
+        m_SumY = 0.0;
+        m_SumSquared = 0.0;
+        m_OriginX = 0.0;
+        m_OriginY = 0.0;
+    }
+
+    //! Has any activity been decoded?
+    bool hasEstimate() const{ return (m_SumWeight > 0.0); }
+
+    //! Filtered number of spikes i.e. sum of all spikes weighted by e^(-age / tau)
+    double getFilteredSpikes() const{ return m_SumWeight; }
+
+    //! Centroid of filtered spikes (cells)
+    double getX() const{ return m_OriginX + getRelativeX(); }
+    double getY() const{ return m_OriginY + getRelativeY(); }
+
+    //! RMS distance of filtered spikes from centroid (cells)
+    double getSpread() const{ return std::sqrt(getVariance()); }
+
+    //! Confidence in decoded position between 0 and 1
+    double getConfidence() const
+    {
+        const double activity = m_SumWeight / (m_SumWeight + 1.0);
+        const double compactness = m_ExpectedVariance / (m_ExpectedVariance + getVariance());
+        return activity * compactness;
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    //! Filtered spike count below which past activity is discarded
+    static constexpr double minWeight = 1E-6;
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    double getRelativeX() const{ return hasEstimate() ? (m_SumX / m_SumWeight) : 0.0; }
+    double getRelativeY() const{ return hasEstimate() ? (m_SumY / m_SumWeight) : 0.0; }
+
+    double getVariance() const
+    {
+        if(!hasEstimate()) {
+            return 0.0;
+        }
+
+        // E[x^2 + y^2] - |E[(x, y)]|^2, clamped as rounding can make it very slightly negative
+        const double x = getRelativeX();
+        const double y = getRelativeY();
+        return std::max(0.0, (m_SumSquared / m_SumWeight) - (x * x) - (y * y));
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const double m_Decay;
+    const double m_ExpectedVariance;
+
+    // Origin coordinates are accumulated relative to
+    double m_OriginX;
+    double m_OriginY;
+
+    // Exponentially-filtered sums of spike count, coordinates and squared coordinates
+    double m_SumWeight;
+    double m_SumX;
+    double m_SumY;
+    double m_SumSquared;
+};
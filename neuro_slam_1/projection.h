@@ -0,0 +1,341 @@
+#pragma once
+
+// Standard C++ includes
+#include <vector>
+
+// Model includes
+#include "grid_stencil.h"
+#include "lif_population.h"
+
+//----------------------------------------------------------------------------
+// Projection
+//----------------------------------------------------------------------------
+//! Interface for static synapse populations with a single (global) weight
+class Projection
+{
+public:
+    Projection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight)
+    :   m_Pre(pre), m_Post(post), m_PostInput(postInput), m_Weight(weight)
+    {
+    }
+
+    virtual ~Projection()
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Declared virtuals
+    //----------------------------------------------------------------------------
+    //! Add weight to inSyn of every postsynaptic target of last timestep's presynaptic spikes
+    virtual void propagate() = 0;
+
+    //! Memory used to store connectivity
+    virtual size_t getConnectivityBytes() const = 0;
+
+protected:
+    //----------------------------------------------------------------------------
+    // Protected API
+    //----------------------------------------------------------------------------
+    const LIFPopulation &getPre() const{ return m_Pre; }
+    LIFPopulation &getPost(){ return m_Post; }
+    unsigned int getPostInput() const{ return m_PostInput; }
+    float *getPostInSyn(){ return m_Post.getInSyn(m_PostInput); }
+    float getWeight() const{ return m_Weight; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const LIFPopulation &m_Pre;
+    LIFPopulation &m_Post;
+    const unsigned int m_PostInput;
+    const float m_Weight;
+};
+
+//----------------------------------------------------------------------------
+// StencilProjection
+//----------------------------------------------------------------------------
+//! Projection whose targets are calculated on the fly from a grid stencil
+template<typename Layout>
+class StencilProjection : public Projection
+{
+public:
+    StencilProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight,
+                      const GridStencil<Layout> &stencil)
+    :   Projection(pre, post, postInput, weight), m_Stencil(stencil)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Projection virtuals
+    //----------------------------------------------------------------------------
+    virtual void propagate() override
+    {
+        LIFPopulation &post = getPost();
+        float *inSyn = getPostInSyn();
+        const float weight = getWeight();
+        for(unsigned int i : getPre().getSpikes()) {
+            m_Stencil.forEachTarget(i, [&post, inSyn, weight](unsigned int j){ inSyn[j] += weight; post.activate(j); });
+        }
+    }
+
+    virtual size_t getConnectivityBytes() const override
+    {
+        return m_Stencil.getConnectivityBytes();
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const GridStencil<Layout> m_Stencil;
+};
+
+//----------------------------------------------------------------------------
+// IdentityProjection
+//----------------------------------------------------------------------------
+//! Projection from each presynaptic neuron i to postsynaptic neuron i (equivalent to OneToOne)
+/*! Propagation is a direct indexed add so no connectivity needs to be stored */
+class IdentityProjection : public Projection
+{
+public:
+    IdentityProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight)
+    :   Projection(pre, post, postInput, weight)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Projection virtuals
+    //----------------------------------------------------------------------------
+    virtual void propagate() override
+    {
+        LIFPopulation &post = getPost();
+        float *inSyn = getPostInSyn();
+        const float weight = getWeight();
+        for(unsigned int i : getPre().getSpikes()) {
+            inSyn[i] += weight;
+            post.activate(i);
+        }
+    }
+
+    virtual size_t getConnectivityBytes() const override
+    {
+        return 0;
+    }
+};
+
+//----------------------------------------------------------------------------
+// RaggedProjection
+//----------------------------------------------------------------------------
+//! Projection with connectivity stored in the same ragged format as GeNN's RAGGED_GLOBALG
+class RaggedProjection : public Projection
+{
+public:
+    //----------------------------------------------------------------------------
+    // AddSynapse
+    //----------------------------------------------------------------------------
+    //! Functor passed to row build functions to add a synapse to the current row
+    class AddSynapse
+    {
+    public:
+        AddSynapse(unsigned int *rowInd, unsigned int &rowLength) : m_RowInd(rowInd), m_RowLength(rowLength)
+        {
+        }
+
+        void operator()(unsigned int j) const
+        {
+            m_RowInd[m_RowLength++] = j;
+        }
+
+    private:
+        unsigned int *m_RowInd;
+        unsigned int &m_RowLength;
+    };
+
+    //! Build ragged matrix by calling buildRow(i, addSynapse) for each presynaptic neuron
+    //! (equivalent to the row build code of an InitSparseConnectivitySnippet)
+    template<typename BuildRow>
+    RaggedProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight,
+                     unsigned int maxRowLength, BuildRow buildRow)
+    :   Projection(pre, post, postInput, weight), m_MaxRowLength(maxRowLength),
+        m_OwnedRowLength(pre.getSize(), 0), m_OwnedInd(pre.getSize() * m_MaxRowLength),
+        m_RowLength(m_OwnedRowLength.data()), m_Ind(m_OwnedInd.data())
+    {
+        for(unsigned int i = 0; i < pre.getSize(); i++) {
+            buildRow(i, AddSynapse(&m_OwnedInd[i * m_MaxRowLength], m_OwnedRowLength[i]));
+        }
+    }
+
+    //! Use existing ragged matrix e.g. from a ConnectivityCache
+    /*! **NOTE** rowLength and ind are not copied so must outlive the projection */
+    RaggedProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight,
+                     unsigned int maxRowLength, const unsigned int *rowLength, const unsigned int *ind)
+    :   Projection(pre, post, postInput, weight), m_MaxRowLength(maxRowLength), m_RowLength(rowLength), m_Ind(ind)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Projection virtuals
+    //----------------------------------------------------------------------------
+    virtual void propagate() override
+    {
+        LIFPopulation &post = getPost();
+        float *inSyn = getPostInSyn();
+        const float weight = getWeight();
+        for(unsigned int i : getPre().getSpikes()) {
+            const unsigned int *rowInd = &m_Ind[i * m_MaxRowLength];
+            for(unsigned int s = 0; s < m_RowLength[i]; s++) {
+                inSyn[rowInd[s]] += weight;
+                post.activate(rowInd[s]);
+            }
+        }
+    }
+
+    virtual size_t getConnectivityBytes() const override
+    {
+        return sizeof(unsigned int) * getNumRows() * (1 + m_MaxRowLength);
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    unsigned int getNumRows() const{ return getPre().getSize(); }
+    unsigned int getMaxRowLength() const{ return m_MaxRowLength; }
+
+    //! Number of synapses in each of getNumRows() rows
+    const unsigned int *getRowLength() const{ return m_RowLength; }
+
+    //! Postsynaptic indices, getMaxRowLength() per row
+    const unsigned int *getInd() const{ return m_Ind; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_MaxRowLength;
+
+    // Storage for connectivity built by this projection
+    std::vector<unsigned int> m_OwnedRowLength;
+    std::vector<unsigned int> m_OwnedInd;
+
+    const unsigned int *m_RowLength;
+    const unsigned int *m_Ind;
+};
+
+//----------------------------------------------------------------------------
+// MultiStencilProjection
+//----------------------------------------------------------------------------
+//! Projection from a population with one neuron per stencil in each grid cell, laid out [cell][stencil]
+/*! Presynaptic neuron (cell * numStencils) + s connects to the targets of stencil s from cell */
+template<typename Layout>
+class MultiStencilProjection : public Projection
+{
+public:
+    MultiStencilProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight,
+                           const std::vector<GridStencil<Layout>> &stencils)
+    :   Projection(pre, post, postInput, weight), m_Stencils(stencils)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Projection virtuals
+    //----------------------------------------------------------------------------
+    virtual void propagate() override
+    {
+        LIFPopulation &post = getPost();
+        float *inSyn = getPostInSyn();
+        const float weight = getWeight();
+        const unsigned int numStencils = (unsigned int)m_Stencils.size();
+        for(unsigned int i : getPre().getSpikes()) {
+            m_Stencils[i % numStencils].forEachTarget(i / numStencils,
+                                                      [&post, inSyn, weight](unsigned int j){ inSyn[j] += weight; post.activate(j); });
+        }
+    }
+
+    virtual size_t getConnectivityBytes() const override
+    {
+        size_t bytes = 0;
+        for(const auto &s : m_Stencils) {
+            bytes += s.getConnectivityBytes();
+        }
+        return bytes;
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const std::vector<GridStencil<Layout>> m_Stencils;
+};
+
+//----------------------------------------------------------------------------
+// FanOutProjection
+//----------------------------------------------------------------------------
+//! Projection from each presynaptic neuron i to the contiguous block of postsynaptic
+//! neurons [i * fanOut, (i + 1) * fanOut) - a fused set of identity projections
+class FanOutProjection : public Projection
+{
+public:
+    FanOutProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight,
+                     unsigned int fanOut)
+    :   Projection(pre, post, postInput, weight), m_FanOut(fanOut)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Projection virtuals
+    //----------------------------------------------------------------------------
+    virtual void propagate() override
+    {
+        LIFPopulation &post = getPost();
+        float *inSyn = getPostInSyn();
+        const float weight = getWeight();
+        for(unsigned int i : getPre().getSpikes()) {
+            const unsigned int jBegin = i * m_FanOut;
+            for(unsigned int j = jBegin; j < (jBegin + m_FanOut); j++) {
+                inSyn[j] += weight;
+                post.activate(j);
+            }
+        }
+    }
+
+    virtual size_t getConnectivityBytes() const override
+    {
+        return sizeof(m_FanOut);
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_FanOut;
+};
+
+//----------------------------------------------------------------------------
+// BroadcastProjection
+//----------------------------------------------------------------------------
+//! Projection from presynaptic neuron i to every postsynaptic neuron in channel i (equivalent to DirectionRow)
+/*! As every postsynaptic neuron in a channel receives identical input, it is added to the channel's global inSyn */
+class BroadcastProjection : public Projection
+{
+public:
+    BroadcastProjection(const LIFPopulation &pre, LIFPopulation &post, unsigned int postInput, float weight)
+    :   Projection(pre, post, postInput, weight)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Projection virtuals
+    //----------------------------------------------------------------------------
+    virtual void propagate() override
+    {
+        for(unsigned int i : getPre().getSpikes()) {
+            getPost().addGlobalInSyn(getPostInput(), i, getWeight());
+        }
+    }
+
+    virtual size_t getConnectivityBytes() const override
+    {
+        return 0;
+    }
+};
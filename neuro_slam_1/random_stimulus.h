@@ -0,0 +1,15 @@
+#pragma once
+
+// Standard C includes
+#include <cstdint>
+
+//! Pseudorandomly select fractionPercent% of grid cells by hashing their coordinates
+//! so benchmarks stimulate the same cells whatever the layout or partitioning
+inline bool isStimulated(unsigned int x, unsigned int y, unsigned int fractionPercent)
+{
+    uint32_t h = (x * 0x8DA6B343) ^ (y * 0xD8163841);
+    h ^= h >> 16;
+    h *= 0x7FEB352D;
+    h ^= h >> 15;
+    return (h % 100) < fractionPercent;
+}
@@ -0,0 +1,132 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Standard C includes
+#include <cstdlib>
+#include <cstring>
+
+// Model includes
+#include "grid_layout.h"
+#include "grid_network.h"
+#include "odometry_driver.h"
+#include "odometry_log.h"
+#include "parameters.h"
+#include "position_decoder.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+// Current used to place initial bump of activity and to hold direction neurons active (nA)
+const float stimulusCurrent = 2.0f;
+
+// How long is the initial bump stimulated for before odometry is replayed?
+const unsigned int numStimulusTimesteps = 20;
+
+// How often is decoded position reported?
+const uint64_t reportIntervalTimesteps = 1000;
+
+void printUsage()
+{
+    std::cerr << "Usage: replay [--preload] [--active-set] [--layout row-major|tiled|morton] <odometry log filename> [<width> <height>]" << std::endl;
+}
+
+template<typename Layout>
+void replay(const OdometryLog &log, unsigned int width, unsigned int height, bool activeSet)
+{
+    GridNetwork<Layout> network(width, height, true, activeSet);
+    PositionDecoder decoder(Parameters::decoderTauMs, Parameters::timestepMs, Parameters::decoderExpectedSpread);
+
+    // Hold agent stationary and stimulate neuron in the centre of the world to create initial bump
+    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+        network.setDirectionIExt((Parameters::Direction)d, stimulusCurrent);
+    }
+    const unsigned int centre = network.getLayout().getIndex(width / 2, height / 2);
+    network.getPosition().setIExt(centre, stimulusCurrent);
+    for(unsigned int t = 0; t < numStimulusTimesteps; t++) {
+        network.step();
+        decoder.update(network.getLayout(), network.getPosition().getSpikes());
+    }
+    network.getPosition().setIExt(centre, 0.0f);
+
+    // Replay odometry
+    OdometryDriver driver(log, stimulusCurrent);
+    const auto start = std::chrono::high_resolution_clock::now();
+    while(driver.apply(network)) {
+        network.step();
+        decoder.update(network.getLayout(), network.getPosition().getSpikes());
+
+        if((driver.getStep() % reportIntervalTimesteps) == 0) {
+            std::cout << driver.getStep() << ": (" << decoder.getX() << ", " << decoder.getY() << "), confidence "
+                << decoder.getConfidence() << std::endl;
+        }
+    }
+    const std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+
+    const double stepsPerSecond = (double)log.getNumSteps() / duration.count();
+    std::cout << "Replayed " << log.getNumSteps() << " timesteps (" << (log.isPreloaded() ? "preloaded" : "memory-mapped")
+        << ") in " << duration.count() << "s: " << stepsPerSecond << " steps/s, "
+        << (stepsPerSecond * Parameters::timestepMs) / 1000.0 << "x real time" << std::endl;
+    std::cout << "Decoded position: (" << decoder.getX() << ", " << decoder.getY() << "), spread " << decoder.getSpread()
+        << " cells, confidence " << decoder.getConfidence() << std::endl;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bool preload = false;
+    bool activeSet = false;
+    std::string layout = RowMajorLayout::getName();
+    unsigned int width = Parameters::worldWidth;
+    unsigned int height = Parameters::worldHeight;
+
+    // Parse options
+    int a = 1;
+    for(; a < argc && std::strncmp(argv[a], "--", 2) == 0; a++) {
+        if(std::strcmp(argv[a], "--preload") == 0) {
+            preload = true;
+        }
+        else if(std::strcmp(argv[a], "--active-set") == 0) {
+            activeSet = true;
+        }
+        else if(std::strcmp(argv[a], "--layout") == 0 && (a + 1) < argc) {
+            layout = argv[++a];
+        }
+        else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    const int numPositional = argc - a;
+    if(numPositional != 1 && numPositional != 3) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    if(numPositional == 3) {
+        width = std::atoi(argv[a + 1]);
+        height = std::atoi(argv[a + 2]);
+    }
+    if(width == 0 || height == 0) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const OdometryLog log(argv[a], preload);
+    if(layout == RowMajorLayout::getName()) {
+        replay<RowMajorLayout>(log, width, height, activeSet);
+    }
+    else if(layout == TiledLayout<>::getName()) {
+        replay<TiledLayout<>>(log, width, height, activeSet);
+    }
+    else if(layout == MortonLayout::getName()) {
+        replay<MortonLayout>(log, width, height, activeSet);
+    }
+    else {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
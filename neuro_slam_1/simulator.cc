@@ -0,0 +1,139 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// Standard C includes
+#include <cstdlib>
+#include <cstring>
+
+// Model includes
+#include "grid_layout.h"
+#include "grid_network.h"
+#include "parameters.h"
+#include "position_decoder.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+// Current used to place initial bump of activity and to hold direction neurons active (nA)
+const float stimulusCurrent = 2.0f;
+
+// How long is the initial bump stimulated for?
+const unsigned int numStimulusTimesteps = 20;
+
+void printUsage()
+{
+    std::cerr << "Usage: simulator [--ragged [--connectivity-cache <filename>]] [--active-set] [--layout row-major|tiled|morton] [<width> <height>] [<number of timesteps>]" << std::endl;
+}
+
+template<typename Layout>
+void simulate(unsigned int width, unsigned int height, bool procedural, bool activeSet,
+              const std::string &connectivityCacheFilename, unsigned int numTimesteps)
+{
+    const auto buildStart = std::chrono::high_resolution_clock::now();
+    GridNetwork<Layout> network(width, height, procedural, activeSet, connectivityCacheFilename);
+    const std::chrono::duration<double> buildDuration = std::chrono::high_resolution_clock::now() - buildStart;
+
+    std::cout << width << "x" << height << " world with " << Layout::getName() << " layout and "
+        << (procedural ? "procedural" : "ragged") << " connectivity: " << network.getConnectivityBytes()
+        << " bytes, " << (network.isConnectivityCached() ? "loaded from cache" : "built") << " in "
+        << buildDuration.count() << "s" << std::endl;
+
+    // Keep all direction neurons active so interneurons are inhibited and bump stays put
+    for(unsigned int d = 0; d < Parameters::DirectionMax; d++) {
+        network.getDirection().setIExt(d, stimulusCurrent);
+    }
+
+    // Stimulate neuron in the centre of the world to create initial bump
+    const unsigned int centre = network.getLayout().getIndex(width / 2, height / 2);
+    network.getPosition().setIExt(centre, stimulusCurrent);
+
+    PositionDecoder decoder(Parameters::decoderTauMs, Parameters::timestepMs, Parameters::decoderExpectedSpread);
+
+    unsigned long long numPositionSpikes = 0;
+    unsigned long long numNeuronUpdates = 0;
+    const auto simStart = std::chrono::high_resolution_clock::now();
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        if(t == numStimulusTimesteps) {
+            network.getPosition().setIExt(centre, 0.0f);
+        }
+
+        numNeuronUpdates += network.getNumActive();
+        network.step();
+        numPositionSpikes += network.getPosition().getSpikes().size();
+        decoder.update(network.getLayout(), network.getPosition().getSpikes());
+    }
+    const std::chrono::duration<double, std::micro> simDuration = std::chrono::high_resolution_clock::now() - simStart;
+
+    std::cout << numTimesteps << " timesteps: " << simDuration.count() / (double)numTimesteps << "us per timestep, "
+        << numPositionSpikes << " position spikes, " << numNeuronUpdates / numTimesteps << " neuron updates per timestep" << std::endl;
+    std::cout << "Decoded position: (" << decoder.getX() << ", " << decoder.getY() << "), spread " << decoder.getSpread()
+        << " cells, confidence " << decoder.getConfidence() << std::endl;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    bool procedural = true;
+    bool activeSet = false;
+    std::string layout = RowMajorLayout::getName();
+    std::string connectivityCacheFilename;
+    unsigned int width = Parameters::worldWidth;
+    unsigned int height = Parameters::worldHeight;
+    unsigned int numTimesteps = 1000;
+
+    // Parse options
+    int a = 1;
+    for(; a < argc && std::strncmp(argv[a], "--", 2) == 0; a++) {
+        if(std::strcmp(argv[a], "--ragged") == 0) {
+            procedural = false;
+        }
+        else if(std::strcmp(argv[a], "--active-set") == 0) {
+            activeSet = true;
+        }
+        else if(std::strcmp(argv[a], "--layout") == 0 && (a + 1) < argc) {
+            layout = argv[++a];
+        }
+        else if(std::strcmp(argv[a], "--connectivity-cache") == 0 && (a + 1) < argc) {
+            connectivityCacheFilename = argv[++a];
+        }
+        else {
+            printUsage();
+            return EXIT_FAILURE;
+        }
+    }
+    const int numPositional = argc - a;
+    if(numPositional == 1 || numPositional == 3) {
+        numTimesteps = std::atoi(argv[argc - 1]);
+    }
+    else if(numPositional != 0 && numPositional != 2) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    if(numPositional >= 2) {
+        width = std::atoi(argv[a]);
+        height = std::atoi(argv[a + 1]);
+    }
+    if(width == 0 || height == 0 || (procedural && !connectivityCacheFilename.empty())) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    if(layout == RowMajorLayout::getName()) {
+        simulate<RowMajorLayout>(width, height, procedural, activeSet, connectivityCacheFilename, numTimesteps);
+    }
+    else if(layout == TiledLayout<>::getName()) {
+        simulate<TiledLayout<>>(width, height, procedural, activeSet, connectivityCacheFilename, numTimesteps);
+    }
+    else if(layout == MortonLayout::getName()) {
+        simulate<MortonLayout>(width, height, procedural, activeSet, connectivityCacheFilename, numTimesteps);
+    }
+    else {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
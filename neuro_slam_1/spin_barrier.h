@@ -0,0 +1,55 @@
+#pragma once
+
+// Standard C++ includes
+#include <atomic>
+#include <thread>
+
+//----------------------------------------------------------------------------
+// SpinBarrier
+//----------------------------------------------------------------------------
+//! Reusable barrier for a fixed number of threads
+/*! Threads spin while waiting as the time between barriers is typically far shorter than
+    the latency of waking a thread blocked on a condition variable. After a while they start
+    yielding so the barrier still makes progress if there are more threads than cores. */
+class SpinBarrier
+{
+public:
+    explicit SpinBarrier(unsigned int numThreads) : m_NumThreads(numThreads), m_NumWaiting(0), m_Generation(0)
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    void wait()
+    {
+        const unsigned int generation = m_Generation.load(std::memory_order_acquire);
+
+        // If this is the last thread to arrive, reset count and release other threads
+        if(m_NumWaiting.fetch_add(1, std::memory_order_acq_rel) == (m_NumThreads - 1)) {
+            m_NumWaiting.store(0, std::memory_order_relaxed);
+            m_Generation.fetch_add(1, std::memory_order_release);
+        }
+        // Otherwise, wait for generation to change
+        else {
+            for(unsigned int spins = 0; m_Generation.load(std::memory_order_acquire) == generation; spins++) {
+                if(spins > maxSpins) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr unsigned int maxSpins = 1024;
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_NumThreads;
+    std::atomic<unsigned int> m_NumWaiting;
+    std::atomic<unsigned int> m_Generation;
+};
@@ -0,0 +1,107 @@
+// Standard C++ includes
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Model includes
+#include "lif_population.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+// LIF parameters used by GridNetwork
+const LIFPopulation::Params lifParams = {1.0, 20.0, -70.0, -70.0, -51.0, 0.0, 2.0};
+
+const double dt = 1.0;
+
+//! Input applied to a population at one timestep
+struct Pulse
+{
+    unsigned int timestep;
+    unsigned int input;
+    bool global;
+    unsigned int target;    // Channel if global, otherwise neuron
+    float value;
+};
+
+//! Simulate population with pulses applied before each timestep, returning spikes emitted at each timestep
+std::vector<std::vector<unsigned int>> simulate(bool activeSet, unsigned int size, unsigned int numChannels,
+                                                const std::vector<Pulse> &pulses, unsigned int numTimesteps)
+{
+    LIFPopulation population("Test", size, lifParams, dt, activeSet, numChannels);
+    population.addInput(5.0);
+    population.addInput(10.0);
+
+    std::vector<std::vector<unsigned int>> spikes;
+    auto pulse = pulses.cbegin();
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        for(; pulse != pulses.cend() && pulse->timestep == t; ++pulse) {
+            if(pulse->global) {
+                population.addGlobalInSyn(pulse->input, pulse->target, pulse->value);
+            }
+            else {
+                population.getInSyn(pulse->input)[pulse->target] += pulse->value;
+                population.activate(pulse->target);
+            }
+        }
+        population.update();
+        spikes.push_back(population.getSpikes());
+    }
+    return spikes;
+}
+
+//! Check active-set and dense modes produce identical spike trains
+bool test(const char *name, unsigned int size, unsigned int numChannels, const std::vector<Pulse> &pulses,
+          unsigned int numTimesteps)
+{
+    const auto dense = simulate(false, size, numChannels, pulses, numTimesteps);
+    const auto active = simulate(true, size, numChannels, pulses, numTimesteps);
+
+    size_t numSpikes = 0;
+    for(unsigned int t = 0; t < numTimesteps; t++) {
+        if(dense[t] != active[t]) {
+            std::cerr << name << ": spikes differ at timestep " << t << std::endl;
+            return false;
+        }
+        numSpikes += dense[t].size();
+    }
+    std::cout << name << ": " << numSpikes << " identical spikes" << std::endl;
+    return true;
+}
+}   // Anonymous namespace
+
+int main()
+{
+    bool success = true;
+
+    // Excitatory global input alone pushes every neuron over threshold
+    success &= test("Excitatory broadcast", 4, 1, {{0, 0, true, 0, 10.0f}}, 20);
+
+    // Neurons quiesce after local input and are then woken by excitatory global input
+    success &= test("Broadcast after local input", 4, 2,
+                    {{0, 0, false, 1, 2.0f}, {0, 0, false, 2, -2.0f}, {30, 0, true, 0, 10.0f}, {30, 0, true, 1, 3.0f}}, 60);
+
+    // Random mixture of local and global, excitatory and inhibitory input
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<unsigned int> neuronDist(0, 63);
+    std::uniform_int_distribution<unsigned int> channelDist(0, 1);
+    std::uniform_real_distribution<float> localDist(0.0f, 6.0f);
+    std::uniform_real_distribution<float> globalDist(0.0f, 1.0f);
+    std::vector<Pulse> pulses;
+    for(unsigned int t = 0; t < 1000; t++) {
+        if((t % 50) == 0) {
+            pulses.push_back({t, 0, true, channelDist(gen), 12.0f * globalDist(gen)});
+            pulses.push_back({t, 1, true, channelDist(gen), -4.0f * globalDist(gen)});
+        }
+        pulses.push_back({t, 0, false, neuronDist(gen), localDist(gen)});
+        pulses.push_back({t, 1, false, neuronDist(gen), -localDist(gen)});
+    }
+    success &= test("Random input", 64, 2, pulses, 1000);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,289 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdlib>
+
+// OpenCV includes
+#include <opencv2/opencv.hpp>
+
+//----------------------------------------------------------------------------
+// ActivityRenderer
+//----------------------------------------------------------------------------
+//! Renders population activity and the agent's path on a background thread.
+/*! The simulation thread calls update() every timestep which copies the registered population
+    variables into a lock-free triple buffer and appends the agent's position to a preallocated path
+    buffer. The render thread, which also owns any display windows, wakes at most fps times per second,
+    takes the latest snapshot and only redraws neurons whose 8-bit quantised activity has changed since
+    it was last drawn.
+    Frames can be shown in windows, encoded to a video file or both. */
+template<typename S>
+class ActivityRenderer
+{
+public:
+    typedef cv::Scalar (*ColourFn)(unsigned char);
+
+    ActivityRenderer(unsigned int maxPathPoints, double fps, bool display, const std::string &videoFilename = "",
+                     int pathImageSize = 1000, int activityImageWidth = 500, int activityImageHeight = 500)
+    :   m_FramePeriod(std::chrono::duration<double>(1.0 / fps)), m_Display(display),
+        m_PathImage(pathImageSize, pathImageSize, CV_8UC3, cv::Scalar::all(0)),
+        m_ActivityImage(activityImageHeight, activityImageWidth, CV_8UC3, cv::Scalar::all(0)),
+        m_PathImageSize(pathImageSize), m_Path(maxPathPoints), m_NumPathPoints(0), m_NumDrawnPathPoints(0),
+        m_BackIndex(0), m_MiddleIndex(1), m_FrontIndex(2), m_Stop(false)
+    {
+        if(!(fps > 0.0)) {
+            throw std::runtime_error("Render frame rate must be positive");
+        }
+
+        if(!videoFilename.empty()) {
+            // **NOTE** video frames have path on the left and activity at the top right
+            m_VideoFrame = cv::Mat(pathImageSize, pathImageSize + activityImageWidth, CV_8UC3, cv::Scalar::all(0));
+            m_VideoWriter = cv::VideoWriter(videoFilename, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), fps,
+                                            cv::Size(pathImageSize + activityImageWidth, pathImageSize));
+            if(!m_VideoWriter.isOpened()) {
+                throw std::runtime_error("Cannot open video file '" + videoFilename + "'");
+            }
+        }
+    }
+
+    ~ActivityRenderer()
+    {
+        stop();
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Register population to render. Must be called before start()
+    void addPopulation(const S *variable, int popSize, const char *popName, const cv::Point &position,
+                       ColourFn getColourFn, int numColumns = 0)
+    {
+        // If (invalid) default number of columns is specified, use popsize
+        if(numColumns == 0) {
+            numColumns = popSize;
+        }
+
+        // Allocate space for population in each buffer
+        m_Populations.push_back({variable, popSize, numColumns, position, getColourFn,
+                                 m_Frames[0].size(), std::vector<int>(popSize, -1)});
+        for(auto &f : m_Frames) {
+            f.resize(f.size() + popSize);
+        }
+
+        // Label population
+        const int numRows = (int)ceil((double)popSize / (double)numColumns);
+        cv::putText(m_ActivityImage, popName, position + cv::Point(0, 17 + (27 * numRows)),
+                    cv::FONT_HERSHEY_COMPLEX_SMALL, 1.0, CV_RGB(0xFF, 0xFF, 0xFF));
+    }
+
+    //! Start render thread
+    void start()
+    {
+        m_Thread = std::thread(&ActivityRenderer::renderThread, this);
+    }
+
+    //! Stop render thread, after rendering final state
+    void stop()
+    {
+        if(m_Thread.joinable()) {
+            m_Stop.store(true, std::memory_order_release);
+            m_Thread.join();
+        }
+    }
+
+    //! Snapshot population activity and add agent position to path - called from simulation thread
+    void update(double xPosition, double yPosition, bool outbound)
+    {
+        // Copy populations into back buffer
+        std::vector<S> &back = m_Frames[m_BackIndex];
+        for(const auto &p : m_Populations) {
+            std::copy_n(p.variable, p.popSize, &back[p.offset]);
+        }
+
+        // Swap back buffer with middle, marking it as fresh
+        m_BackIndex = m_MiddleIndex.exchange(m_BackIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+
+        // If there's space, add agent position (centring so origin is in centre of path image) to path
+        const size_t numPathPoints = m_NumPathPoints.load(std::memory_order_relaxed);
+        if(numPathPoints < m_Path.size()) {
+            m_Path[numPathPoints] = {(m_PathImageSize / 2) + (int)xPosition, (m_PathImageSize / 2) + (int)yPosition, outbound};
+            m_NumPathPoints.store(numPathPoints + 1, std::memory_order_release);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    static cv::Scalar getReds(unsigned char gray)
+    {
+        return CV_RGB(gray, 0, 0);
+    }
+
+    static cv::Scalar getGreens(unsigned char gray)
+    {
+        return CV_RGB(0, gray, 0);
+    }
+
+    static cv::Scalar getBlues(unsigned char gray)
+    {
+        return CV_RGB(0, 0, gray);
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Population
+    //----------------------------------------------------------------------------
+    struct Population
+    {
+        const S *variable;
+        int popSize;
+        int numColumns;
+        cv::Point position;
+        ColourFn getColourFn;
+
+        // Offset of population within buffers
+        size_t offset;
+
+        // Quantised activity last drawn for each neuron
+        std::vector<int> drawnGray;
+    };
+
+    //----------------------------------------------------------------------------
+    // PathPoint
+    //----------------------------------------------------------------------------
+    struct PathPoint
+    {
+        int x;
+        int y;
+        bool outbound;
+    };
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void renderThread()
+    {
+        // **NOTE** HighGUI windows must be created, shown and destroyed by the same
+        // thread so, if display is enabled, the render thread owns them entirely
+        if(m_Display) {
+            cv::namedWindow("Path", CV_WINDOW_NORMAL);
+            cv::resizeWindow("Path", m_PathImage.cols, m_PathImage.rows);
+
+            cv::namedWindow("Activity", CV_WINDOW_NORMAL);
+            cv::resizeWindow("Activity", m_ActivityImage.cols, m_ActivityImage.rows);
+            cv::moveWindow("Activity", m_PathImage.cols, 0);
+        }
+
+        bool stopping = false;
+        do {
+            // Read stop flag before rendering so final state is always rendered
+            const auto frameStart = std::chrono::steady_clock::now();
+            stopping = m_Stop.load(std::memory_order_acquire);
+
+            renderFrame();
+
+            std::this_thread::sleep_until(frameStart + m_FramePeriod);
+        } while(!stopping);
+
+        if(m_Display) {
+            cv::destroyWindow("Path");
+            cv::destroyWindow("Activity");
+        }
+    }
+
+    void renderFrame()
+    {
+        // If there's a fresh snapshot, swap it with front buffer and draw changed neurons
+        if(m_MiddleIndex.load(std::memory_order_acquire) & freshBit) {
+            m_FrontIndex = m_MiddleIndex.exchange(m_FrontIndex, std::memory_order_acq_rel) & indexMask;
+
+            const std::vector<S> &front = m_Frames[m_FrontIndex];
+            for(auto &p : m_Populations) {
+                for(int i = 0; i < p.popSize; i++) {
+                    // Convert activity to a 8-bit level
+                    const S activity = front[p.offset + i];
+                    const unsigned char gray = (unsigned char)(255.0f * std::min(1.0f, std::max(0.0f, (float)activity)));
+
+                    // If it's changed, calculate coordinate in terms of rows and columns and draw rectangle of this colour
+                    if(gray != p.drawnGray[i]) {
+                        auto coord = std::div(i, p.numColumns);
+                        const cv::Point position = p.position + cv::Point(coord.rem * 27, coord.quot * 27);
+                        cv::rectangle(m_ActivityImage, position, position + cv::Point(25, 25), p.getColourFn(gray), cv::FILLED);
+                        p.drawnGray[i] = gray;
+                    }
+                }
+            }
+        }
+
+        // Draw any new path points
+        const size_t numPathPoints = m_NumPathPoints.load(std::memory_order_acquire);
+        for(; m_NumDrawnPathPoints < numPathPoints; m_NumDrawnPathPoints++) {
+            const PathPoint &point = m_Path[m_NumDrawnPathPoints];
+            const cv::Point p(point.x, point.y);
+            cv::line(m_PathImage, p, p,
+                     point.outbound ? CV_RGB(0xFF, 0, 0) : CV_RGB(0, 0xFF, 0));
+        }
+
+        // Show output images
+        if(m_Display) {
+            cv::imshow("Path", m_PathImage);
+            cv::imshow("Activity", m_ActivityImage);
+            cv::waitKey(1);
+        }
+
+        // Compose and write video frame
+        if(m_VideoWriter.isOpened()) {
+            cv::Mat pathROI = m_VideoFrame(cv::Rect(0, 0, m_PathImage.cols, m_PathImage.rows));
+            cv::Mat activityROI = m_VideoFrame(cv::Rect(m_PathImage.cols, 0, m_ActivityImage.cols, m_ActivityImage.rows));
+            m_PathImage.copyTo(pathROI);
+            m_ActivityImage.copyTo(activityROI);
+            m_VideoWriter.write(m_VideoFrame);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr unsigned int indexMask = 3;
+    static constexpr unsigned int freshBit = 4;
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const std::chrono::duration<double> m_FramePeriod;
+    const bool m_Display;
+
+    // Images - only accessed by render thread once started
+    cv::Mat m_PathImage;
+    cv::Mat m_ActivityImage;
+    cv::Mat m_VideoFrame;
+    cv::VideoWriter m_VideoWriter;
+    const int m_PathImageSize;
+
+    std::vector<Population> m_Populations;
+
+    // Path points written by simulation thread and published by incrementing m_NumPathPoints
+    std::vector<PathPoint> m_Path;
+    std::atomic<size_t> m_NumPathPoints;
+    size_t m_NumDrawnPathPoints;
+
+    // Triple buffer of population activity - back buffer is owned by the simulation thread, front buffer by the
+    // render thread and the index of the middle buffer is exchanged between them along with a fresh flag
+    std::array<std::vector<S>, 3> m_Frames;
+    unsigned int m_BackIndex;
+    std::atomic<unsigned int> m_MiddleIndex;
+    unsigned int m_FrontIndex;
+
+    std::atomic<bool> m_Stop;
+    std::thread m_Thread;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+// Standard C++ includes
+#include <numeric>
+
+// Standard C includes
+#include <cmath>
+
+// Model includes
+#include "connectivity.h"
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// AgentState
+//----------------------------------------------------------------------------
+//! Kinematic state of the simulated agent
+struct AgentState
+{
+    double theta;
+    double xVelocity;
+    double yVelocity;
+    double xPosition;
+    double yPosition;
+};
+
+//----------------------------------------------------------------------------
+// Free functions
+//----------------------------------------------------------------------------
+//! Apply angular velocity and linear acceleration to agent
+inline void updateAgent(AgentState &state, double omega, double a)
+{
+    // Update heading
+    state.theta += omega;
+
+    // Update linear velocity
+    // **NOTE** this comes from https://github.com/InsectRobotics/path-integration/blob/master/bee_simulator.py#L77-L83 rather than the methods section
+    state.xVelocity += sin(state.theta) * a;
+    state.yVelocity += cos(state.theta) * a;
+    state.xVelocity -= Parameters::agentDrag * state.xVelocity;
+    state.yVelocity -= Parameters::agentDrag * state.yVelocity;
+
+    // Update position
+    state.xPosition += state.xVelocity;
+    state.yPosition += state.yVelocity;
+}
+
+//! Calculate angular velocity to steer agent home from CPU1 motor output
+template<typename S>
+double getHomingAngularVelocity(const S *rCPU1, unsigned int numCPU1)
+{
+    // Sum left and right motor activity
+    const unsigned int hemisphereSize = Connectivity::getHemisphereSize(numCPU1);
+    const S leftMotor = std::accumulate(&rCPU1[0], &rCPU1[hemisphereSize], S(0.0));
+    const S rightMotor = std::accumulate(&rCPU1[hemisphereSize], &rCPU1[numCPU1], S(0.0));
+
+    // Use difference between left and right to calculate angular velocity
+    // **NOTE** this is scaled so turning gain doesn't depend on the number of columns
+    return -Parameters::agentM * (rightMotor - leftMotor) * (Parameters::referenceHemisphereSize / (double)hemisphereSize);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <stdexcept>
+
+// Standard C includes
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Model includes
+#include "philox.h"
+
+//----------------------------------------------------------------------------
+// BatchVonMisesDistribution
+//----------------------------------------------------------------------------
+//! Samples whole blocks of Von Mises distributed angles using Best and Fisher's (1979) rejection algorithm
+/*! Rather than sampling one angle at a time with a data-dependent rejection loop, fill() draws the
+    random bits for a chunk of candidates at once and then evaluates every candidate in straight-line
+    loops over structure-of-arrays buffers which the compiler can vectorise. Accepted candidates are
+    compacted into the output and the process repeats for the (for the kappa values we use, very few)
+    rejected ones. The number of random bits consumed only depends on the random bits themselves
+    so, with a counter-based generator, the samples are bit-reproducible. */
+template<typename T>
+class BatchVonMisesDistribution
+{
+public:
+    BatchVonMisesDistribution(T mu, T kappa) : m_Mu(mu), m_Kappa(kappa)
+    {
+        if(kappa <= T(0)) {
+            throw std::runtime_error("Von Mises concentration must be positive");
+        }
+
+        const T tau = T(1) + std::sqrt(T(1) + (T(4) * kappa * kappa));
+        const T rho = (tau - std::sqrt(T(2) * tau)) / (T(2) * kappa);
+        m_R = (T(1) + (rho * rho)) / (T(2) * rho);
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Fill output with n samples
+    template<typename Generator>
+    void fill(Generator &gen, T *output, size_t n)
+    {
+        const T pi = T(3.141592653589793238462643383279502884);
+
+        uint32_t bits[3 * chunkSize];
+        T f[chunkSize];
+        T sign[chunkSize];
+        bool accept[chunkSize];
+        while(n > 0) {
+            // Draw three uniforms per candidate
+            const size_t numCandidates = (n < chunkSize) ? n : chunkSize;
+            fillRandomBits(gen, bits, 3 * numCandidates);
+
+            // Evaluate candidates
+            for(size_t i = 0; i < numCandidates; i++) {
+                const T u1 = (T)toUniform(bits[i]);
+                const T u2 = (T)toUniform(bits[numCandidates + i]);
+                const T u3 = (T)toUniform(bits[(2 * numCandidates) + i]);
+
+                const T z = std::cos(pi * u1);
+                f[i] = (T(1) + (m_R * z)) / (m_R + z);
+                const T c = m_Kappa * (m_R - f[i]);
+                accept[i] = ((c * (T(2) - c)) - u2 > T(0)) || ((std::log(c / u2) + T(1) - c) >= T(0));
+                sign[i] = (u3 > T(0.5)) ? T(1) : T(-1);
+            }
+
+            // Write accepted candidates to output
+            for(size_t i = 0; i < numCandidates; i++) {
+                if(accept[i]) {
+                    *output++ = m_Mu + (sign[i] * std::acos(std::min(T(1), std::max(T(-1), f[i]))));
+                    n--;
+                }
+            }
+        }
+    }
+
+    //! Sample a single angle
+    template<typename Generator>
+    T operator()(Generator &gen)
+    {
+        T output;
+        fill(gen, &output, 1);
+        return output;
+    }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr size_t chunkSize = 256;
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const T m_Mu;
+    const T m_Kappa;
+    T m_R;
+};
@@ -0,0 +1,100 @@
+// Standard C++ includes
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Model includes
+#include "fused_step.h"
+#include "homing_trial.h"
+#include "outbound_route.h"
+#include "parameters.h"
+#include "philox.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+typedef float scalar;
+
+//! Calculate memory the GeNN model would require for neuron state, synaptic input and connectivity
+size_t getGeNNModelBytes(unsigned int numColumns)
+{
+    const size_t numTB1 = Connectivity::getHemisphereSize(numColumns);
+
+    // r and speed/iDir/i variables for TN2, TB1 and CPU4 and r for Pontine and CPU1
+    const size_t numNeuronVars = (2 * Parameters::numTN2) + (2 * numTB1) + (2 * numColumns) + numColumns + numColumns;
+
+    // One inSyn per postsynaptic neuron for TB1_TB1 and the six sparse projections
+    const size_t numInSyn = numTB1 + (6 * numColumns);
+
+    // Dense TB1_TB1 weights
+    const size_t numWeights = numTB1 * numTB1;
+
+    // indInG (numPre + 1) and ind (one per synapse) for CPU4_Pontine, TB1_CPU4,
+    // TB1_CPU1, CPU4_CPU1, TN2_CPU4 and Pontine_CPU1
+    const size_t numIndices = ((numColumns + 1) + numColumns) + (2 * ((numTB1 + 1) + numColumns))
+        + ((numColumns + 1) + numColumns) + ((Parameters::numTN2 + 1) + numColumns) + ((numColumns + 1) + numColumns);
+
+    return ((numNeuronVars + numInSyn + numWeights) * sizeof(scalar)) + (numIndices * sizeof(unsigned int));
+}
+
+template<unsigned int NumColumns>
+void benchmark(const std::vector<AgentState> &outboundRoutes, unsigned int numTrials)
+{
+    typedef FusedStep<scalar, NumColumns> Network;
+
+    std::vector<double> preferredAngleTB1(Network::numTB1);
+    for(unsigned int i = 0; i < Network::numTB1; i++) {
+        preferredAngleTB1[i] = Parameters::getPreferredAngleTB1(i, Network::numTB1);
+    }
+
+    double totalStepTime = 0.0;
+    double totalOutboundDistance = 0.0;
+    double totalClosestDistance = 0.0;
+    double totalRelativeError = 0.0;
+    for(unsigned int t = 0; t < numTrials; t++) {
+        // **NOTE** TB1->TB1 weights get big so allocate network on heap
+        std::unique_ptr<Network> network(new Network(preferredAngleTB1.data()));
+        const HomingResult result = runHomingTrial(*network, &outboundRoutes[t * Parameters::numOutwardTimesteps]);
+
+        totalStepTime += result.stepTime;
+        totalOutboundDistance += result.outboundDistance;
+        totalClosestDistance += result.closestDistance;
+        totalRelativeError += result.closestDistance / result.outboundDistance;
+    }
+
+    const unsigned int numSteps = numTrials * (Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps);
+    std::cout << NumColumns << ", " << (totalStepTime * 1000000.0) / (double)numSteps << ", "
+        << sizeof(Network) << ", " << getGeNNModelBytes(NumColumns) << ", "
+        << totalOutboundDistance / (double)numTrials << ", " << totalClosestDistance / (double)numTrials << ", "
+        << totalRelativeError / (double)numTrials << std::endl;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int numTrials = (argc > 1) ? std::atoi(argv[1]) : 10;
+    const unsigned int seed = (argc > 2) ? std::atoi(argv[2]) : 1234;
+
+    // Generate routes up front so every column count is tested on the same set of routes
+    std::vector<AgentState> outboundRoutes(numTrials * Parameters::numOutwardTimesteps);
+    for(unsigned int t = 0; t < numTrials; t++) {
+        Philox4x32 gen(seed, t);
+        generateOutboundRoute(gen, &outboundRoutes[t * Parameters::numOutwardTimesteps]);
+    }
+
+    std::cout << "Num columns, Step time [us], Fused state [bytes], GeNN state [bytes], Outbound distance, Closest distance, Relative homing error" << std::endl;
+    benchmark<8>(outboundRoutes, numTrials);
+    benchmark<16>(outboundRoutes, numTrials);
+    benchmark<32>(outboundRoutes, numTrials);
+    benchmark<64>(outboundRoutes, numTrials);
+    benchmark<128>(outboundRoutes, numTrials);
+    benchmark<256>(outboundRoutes, numTrials);
+    benchmark<512>(outboundRoutes, numTrials);
+    benchmark<1024>(outboundRoutes, numTrials);
+    return EXIT_SUCCESS;
+}
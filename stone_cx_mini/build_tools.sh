@@ -0,0 +1,7 @@
+#!/bin/bash
+# Standalone tools which don't require GeNN-generated code
+g++ benchmark_columns.cc -std=c++11 -O3 -march=native -o benchmark_columns
+g++ encoder_accuracy.cc -std=c++11 -O3 -march=native -o encoder_accuracy
+g++ generate_routes.cc -std=c++11 -O3 -march=native -o generate_routes
+g++ homing_precision.cc -std=c++11 -O3 -march=native -o homing_precision
+g++ homing_variants.cc -std=c++11 -O3 -march=native -o homing_variants
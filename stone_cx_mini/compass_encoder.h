@@ -0,0 +1,184 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+
+// Model includes
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// CompassEncoder
+//----------------------------------------------------------------------------
+//! Converts the agent's heading and velocity into TB1 and TN2 input using a heading-indexed lookup table.
+/*! Each row of the table holds the TL->CL1->TB1 encoding for every TB1 neuron followed by
+    sin and cos of the heading offset by each TN2 neuron's preferred angle. Encoding a heading
+    therefore requires one index calculation and a linear interpolation between two rows. */
+template<typename S>
+class CompassEncoder
+{
+public:
+    CompassEncoder(unsigned int numTB1, unsigned int tableSize = 1024)
+    :   m_NumTB1(numTB1), m_TableSize(tableSize), m_RowSize(numTB1 + (2 * Parameters::numTN2)),
+        m_Table((tableSize + 1) * m_RowSize)
+    {
+        // Table size must be a power of two so headings can be wrapped with a mask
+        if((tableSize & (tableSize - 1)) != 0) {
+            throw std::runtime_error("Compass encoder table size must be a power of two");
+        }
+
+        // Fill table with analytic encoding, including one extra row so interpolation never needs to wrap
+        for(unsigned int i = 0; i <= tableSize; i++) {
+            const double theta = 2.0 * Parameters::pi * (double)i / (double)tableSize;
+
+            S *row = &m_Table[i * m_RowSize];
+            for(unsigned int j = 0; j < m_NumTB1; j++) {
+                row[j] = (S)getTB1Input(Parameters::getPreferredAngleTB1(j, m_NumTB1), theta);
+            }
+            for(unsigned int j = 0; j < Parameters::numTN2; j++) {
+                row[m_NumTB1 + (2 * j)] = (S)sin(theta + Parameters::preferredAngleTN2[j]);
+                row[m_NumTB1 + (2 * j) + 1] = (S)cos(theta + Parameters::preferredAngleTN2[j]);
+            }
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // AccuracyReport
+    //----------------------------------------------------------------------------
+    struct AccuracyReport
+    {
+        double maxTB1Error;
+        double meanTB1Error;
+        double maxTN2Error;
+        double meanTN2Error;
+    };
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    //! Analytic TL->CL1->TB1 encoding (as originally calculated every step in simulator.cc)
+    static double getTB1Input(double preferredAngle, double theta)
+    {
+        const double iTL = cos(preferredAngle - theta);
+        const double iCL = -1.0 / (1.0 + exp(-((6.8 * iTL) - 3.0)));
+        return 1.0 / (1.0 + exp(-((3.0 * iCL) + 0.5)));
+    }
+
+    //! Analytic projection of velocity onto TN2 neuron's preferred angle
+    static double getTN2Input(double preferredAngle, double theta, double xVelocity, double yVelocity)
+    {
+        return (sin(theta + preferredAngle) * xVelocity) + (cos(theta + preferredAngle) * yVelocity);
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Encode a single agent's heading and velocity into TB1 and TN2 input
+    void encode(double theta, double xVelocity, double yVelocity, S *iDirTB1, S *speedTN2) const
+    {
+        unsigned int row;
+        S frac;
+        getTablePosition(theta, row, frac);
+        interpolate(row, frac, xVelocity, yVelocity, iDirTB1, speedTN2);
+    }
+
+    //! Encode many agents at once. iDirTB1 is laid out [agent][TB1] and speedTN2 [agent][TN2]
+    void encodeBatch(unsigned int numAgents, const double *theta, const double *xVelocity, const double *yVelocity,
+                     S *iDirTB1, S *speedTN2) const
+    {
+        // Process agents in chunks so table positions can be calculated in a tight, vectorisable loop
+        constexpr unsigned int chunkSize = 64;
+        unsigned int row[chunkSize];
+        S frac[chunkSize];
+        for(unsigned int start = 0; start < numAgents; start += chunkSize) {
+            const unsigned int numChunkAgents = std::min(chunkSize, numAgents - start);
+            for(unsigned int a = 0; a < numChunkAgents; a++) {
+                getTablePosition(theta[start + a], row[a], frac[a]);
+            }
+
+            for(unsigned int a = 0; a < numChunkAgents; a++) {
+                interpolate(row[a], frac[a], xVelocity[start + a], yVelocity[start + a],
+                            &iDirTB1[(start + a) * m_NumTB1], &speedTN2[(start + a) * Parameters::numTN2]);
+            }
+        }
+    }
+
+    //! Compare lookup table encoding against analytic encoding at numSamples headings
+    AccuracyReport measureAccuracy(unsigned int numSamples) const
+    {
+        AccuracyReport report{0.0, 0.0, 0.0, 0.0};
+        std::vector<S> iDirTB1(m_NumTB1);
+        S speedTN2[Parameters::numTN2];
+
+        // Sample headings over several revolutions (including negative ones) with unit velocity
+        for(unsigned int i = 0; i < numSamples; i++) {
+            const double theta = -4.0 * Parameters::pi + (8.0 * Parameters::pi * (double)i / (double)numSamples);
+            const double xVelocity = sin(0.37 * (double)i);
+            const double yVelocity = cos(0.37 * (double)i);
+            encode(theta, xVelocity, yVelocity, iDirTB1.data(), speedTN2);
+
+            for(unsigned int j = 0; j < m_NumTB1; j++) {
+                const double error = std::fabs((double)iDirTB1[j] - getTB1Input(Parameters::getPreferredAngleTB1(j, m_NumTB1), theta));
+                report.maxTB1Error = std::max(report.maxTB1Error, error);
+                report.meanTB1Error += error;
+            }
+            for(unsigned int j = 0; j < Parameters::numTN2; j++) {
+                const double error = std::fabs((double)speedTN2[j] - getTN2Input(Parameters::preferredAngleTN2[j], theta, xVelocity, yVelocity));
+                report.maxTN2Error = std::max(report.maxTN2Error, error);
+                report.meanTN2Error += error;
+            }
+        }
+
+        report.meanTB1Error /= (double)(numSamples * m_NumTB1);
+        report.meanTN2Error /= (double)(numSamples * Parameters::numTN2);
+        return report;
+    }
+
+    unsigned int getTableSize() const{ return m_TableSize; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    //! Convert (unbounded) heading to table row and interpolation fraction
+    void getTablePosition(double theta, unsigned int &row, S &frac) const
+    {
+        const double position = theta * ((double)m_TableSize / (2.0 * Parameters::pi));
+        const double positionFloor = std::floor(position);
+        row = (unsigned int)((long long)positionFloor & (long long)(m_TableSize - 1));
+        frac = (S)(position - positionFloor);
+    }
+
+    void interpolate(unsigned int row, S frac, double xVelocity, double yVelocity, S *iDirTB1, S *speedTN2) const
+    {
+        const S *row0 = &m_Table[row * m_RowSize];
+        const S *row1 = row0 + m_RowSize;
+
+        // Interpolate TB1 input
+        for(unsigned int j = 0; j < m_NumTB1; j++) {
+            iDirTB1[j] = row0[j] + (frac * (row1[j] - row0[j]));
+        }
+
+        // Interpolate sin and cos of heading offset by TN2 preferred angles and project velocity
+        const S *trig0 = row0 + m_NumTB1;
+        const S *trig1 = row1 + m_NumTB1;
+        for(unsigned int j = 0; j < Parameters::numTN2; j++) {
+            const S s = trig0[2 * j] + (frac * (trig1[2 * j] - trig0[2 * j]));
+            const S c = trig0[(2 * j) + 1] + (frac * (trig1[(2 * j) + 1] - trig0[(2 * j) + 1]));
+            speedTN2[j] = (s * (S)xVelocity) + (c * (S)yVelocity);
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const unsigned int m_NumTB1;
+    const unsigned int m_TableSize;
+    const unsigned int m_RowSize;
+
+    std::vector<S> m_Table;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+// Standard C includes
+#include <cmath>
+
+// Model includes
+#include "parameters.h"
+
+//------------------------------------------------------------------------
+// Connectivity
+//------------------------------------------------------------------------
+//! Closed-form versions of the fixed CX projections. Columns are split evenly
+//! between the left and right hemispheres and each postsynaptic neuron of the
+//! sparse projections receives exactly one synapse so, as well as the
+//! presynaptic -> postsynaptic mapping used to build SparseProjections,
+//! the source of each postsynaptic neuron is also provided for gather-style kernels
+namespace Connectivity
+{
+    constexpr unsigned int getHemisphereSize(unsigned int numColumns)
+    {
+        return numColumns / 2;
+    }
+
+    //! CPU4 and Pontine neurons' projections to CPU1 are offset by a quarter of a hemisphere
+    //! i.e. one column in the original 8 column model. This maintains the same angular offset
+    //! when the number of columns (which must therefore be a multiple of 8) is increased
+    constexpr unsigned int getColumnShift(unsigned int numColumns)
+    {
+        return numColumns / 8;
+    }
+
+    //------------------------------------------------------------------------
+    // TB1->TB1
+    //------------------------------------------------------------------------
+    //! Inhibition between TB1 neurons depends on the difference between their preferred
+    //! angles. It is normalised by the number of TB1 neurons so total inhibition is
+    //! independent of the number of columns (and identical to the original with 8)
+    inline double getTB1TB1Weight(double preferredI, double preferredJ, unsigned int numTB1)
+    {
+        const double w = (cos(preferredI - preferredJ) - 1.0);
+        return Parameters::c * w * (Parameters::referenceHemisphereSize / (double)numTB1);
+    }
+
+    //------------------------------------------------------------------------
+    // TB1->CPU4 and TB1->CPU1
+    //------------------------------------------------------------------------
+    //! Each TB1 neuron connects to the same column in each hemisphere
+    constexpr unsigned int getTBToCPUTarget(unsigned int pre, unsigned int hemisphere, unsigned int numColumns)
+    {
+        return pre + (hemisphere * getHemisphereSize(numColumns));
+    }
+
+    constexpr unsigned int getTBToCPUSource(unsigned int post, unsigned int numColumns)
+    {
+        return post % getHemisphereSize(numColumns);
+    }
+
+    //------------------------------------------------------------------------
+    // TN2->CPU4
+    //------------------------------------------------------------------------
+    //! Each TN2 neuron connects to all the CPU4 neurons in its hemisphere
+    constexpr unsigned int getTN2ToCPU4Source(unsigned int post, unsigned int numColumns)
+    {
+        return post / getHemisphereSize(numColumns);
+    }
+
+    //------------------------------------------------------------------------
+    // CPU4->CPU1
+    //------------------------------------------------------------------------
+    //! CPU4 neurons connect to the opposite hemisphere, shifted by getColumnShift
+    //! (left hemisphere shifts backwards, right hemisphere shifts forwards)
+    //! **NOTE** this mapping is its own inverse so it also gives the source of each CPU1 neuron
+    constexpr unsigned int getCPU4ToCPU1Target(unsigned int pre, unsigned int numColumns)
+    {
+        return (pre < getHemisphereSize(numColumns))
+            ? (getHemisphereSize(numColumns) + ((pre + getHemisphereSize(numColumns) - getColumnShift(numColumns)) % getHemisphereSize(numColumns)))
+            : ((pre - getHemisphereSize(numColumns) + getColumnShift(numColumns)) % getHemisphereSize(numColumns));
+    }
+
+    //------------------------------------------------------------------------
+    // Pontine->CPU1
+    //------------------------------------------------------------------------
+    //! Pontine neurons connect to the opposite hemisphere, shifted by getColumnShift
+    //! (left hemisphere shifts forwards, right hemisphere shifts backwards)
+    //! **NOTE** this mapping is its own inverse so it also gives the source of each CPU1 neuron
+    constexpr unsigned int getPontineToCPU1Target(unsigned int pre, unsigned int numColumns)
+    {
+        return (pre < getHemisphereSize(numColumns))
+            ? (getHemisphereSize(numColumns) + ((pre + getColumnShift(numColumns)) % getHemisphereSize(numColumns)))
+            : ((pre - getColumnShift(numColumns)) % getHemisphereSize(numColumns));
+    }
+
+    //------------------------------------------------------------------------
+    // Sanity checks against the connectivity originally hand-written for 8 columns
+    //------------------------------------------------------------------------
+    static_assert(getCPU4ToCPU1Target(0, 8) == 7 && getCPU4ToCPU1Target(1, 8) == 4
+                  && getCPU4ToCPU1Target(4, 8) == 1 && getCPU4ToCPU1Target(7, 8) == 0,
+                  "CPU4->CPU1 connectivity does not match original model");
+    static_assert(getPontineToCPU1Target(0, 8) == 5 && getPontineToCPU1Target(3, 8) == 4
+                  && getPontineToCPU1Target(4, 8) == 3 && getPontineToCPU1Target(7, 8) == 2,
+                  "Pontine->CPU1 connectivity does not match original model");
+    static_assert(getCPU4ToCPU1Target(getCPU4ToCPU1Target(5, 8), 8) == 5
+                  && getPontineToCPU1Target(getPontineToCPU1Target(6, 8), 8) == 6,
+                  "CPU->CPU1 connectivity is not its own inverse");
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+
+//----------------------------------------------------------------------------
+// ElectrophysRecorder
+//----------------------------------------------------------------------------
+//! Runtime-configurable recording of population state variables.
+/*! Populations are registered with addPopulation but only those enabled by the recording
+    specification passed to the constructor are actually recorded - checkRequests throws if it names any
+    population which was never registered. The specification is a comma-separated
+    list of POPULATION[:INTERVAL] entries (case-insensitive) e.g. "CPU4Memory:10,TB1", or "all".
+    Recording is driven from the simulation loop with
+    \code
+    if(recorder.shouldRecord(i)) {
+        recorder.record(i);
+    }
+    \endcode
+    so, if nothing is enabled, the only per-timestep cost is comparing i against a timestep which is never reached.
+    Simulations may start part way through (e.g. from a Snapshot) in which case sampling begins at the first timestep.
+
+    CSV files have the same "Time [ms], Neuron ID, value" format as AnalogueCSVRecorder. Binary files
+    start with an 8 byte "CXRECORD" magic, a uint32 population size and a uint32 scalar size followed by
+    one record per sample containing a uint32 timestep and population size scalars. */
+template<typename S>
+class ElectrophysRecorder
+{
+public:
+    ElectrophysRecorder(const std::string &specification, bool binary)
+    :   m_Binary(binary), m_NextTimestep(std::numeric_limits<unsigned int>::max())
+    {
+        // Split specification into comma-separated entries
+        std::istringstream specificationStream(specification);
+        std::string entry;
+        while(std::getline(specificationStream, entry, ',')) {
+            if(entry.empty()) {
+                continue;
+            }
+
+            // Split entry into population name and optional interval
+            const size_t colon = entry.find(':');
+            unsigned int interval = 1;
+            if(colon != std::string::npos) {
+                interval = (unsigned int)std::strtoul(entry.c_str() + colon + 1, nullptr, 10);
+                if(interval == 0) {
+                    throw std::runtime_error("Invalid recording interval in '" + entry + "'");
+                }
+            }
+            m_Requests.push_back({toLower(entry.substr(0, colon)), interval, false});
+        }
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Check all requested populations exist - call once every population has been registered
+    //! (populations are added one at a time so this can't be done in addPopulation)
+    void checkRequests() const
+    {
+        for(const auto &r : m_Requests) {
+            if(!r.matched && r.name != "all") {
+                throw std::runtime_error("Population '" + r.name + "' was requested for recording but does not exist");
+            }
+        }
+    }
+
+    //! Register a population which may be recorded - filename is formed from lowercase name
+    void addPopulation(const std::string &name, const S *variable, unsigned int popSize)
+    {
+        // Search for a request for this population (or all populations)
+        const std::string lowerName = toLower(name);
+        auto request = std::find_if(m_Requests.begin(), m_Requests.end(),
+                                    [&lowerName](const Request &r){ return (r.name == lowerName); });
+        if(request == m_Requests.end()) {
+            request = std::find_if(m_Requests.begin(), m_Requests.end(),
+                                   [](const Request &r){ return (r.name == "all"); });
+            if(request == m_Requests.end()) {
+                return;
+            }
+        }
+        request->matched = true;
+
+        // Add population and record from first timestep
+        m_Populations.emplace_back(new Population(lowerName + (m_Binary ? ".bin" : ".csv"), name,
+                                                  variable, popSize, request->interval, m_Binary));
+        m_NextTimestep = 0;
+    }
+
+    //! Is there any population which needs recording at this timestep?
+    bool shouldRecord(unsigned int timestep) const
+    {
+        return (timestep >= m_NextTimestep);
+    }
+
+    //! Record all populations which are due at this timestep
+    void record(unsigned int timestep)
+    {
+        m_NextTimestep = std::numeric_limits<unsigned int>::max();
+        for(auto &p : m_Populations) {
+            if(p->nextTimestep <= timestep) {
+                p->record(timestep);
+            }
+            m_NextTimestep = std::min(m_NextTimestep, p->nextTimestep);
+        }
+    }
+
+    bool isEnabled() const{ return !m_Populations.empty(); }
+
+private:
+    //----------------------------------------------------------------------------
+    // Request
+    //----------------------------------------------------------------------------
+    struct Request
+    {
+        std::string name;
+        unsigned int interval;
+        bool matched;
+    };
+
+    //----------------------------------------------------------------------------
+    // Population
+    //----------------------------------------------------------------------------
+    struct Population
+    {
+        Population(const std::string &filename, const std::string &name, const S *variable,
+                   unsigned int popSize, unsigned int interval, bool binary)
+        :   stream(filename, binary ? std::ios::binary : std::ios::out), variable(variable), popSize(popSize),
+            interval(interval), binary(binary), nextTimestep(0)
+        {
+            if(!stream.good()) {
+                throw std::runtime_error("Cannot open '" + filename + "' for recording");
+            }
+
+            if(binary) {
+                const uint32_t header[2] = {popSize, (uint32_t)sizeof(S)};
+                stream.write("CXRECORD", 8);
+                stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+            }
+            else {
+                stream << "Time [ms], Neuron ID," << name << std::endl;
+            }
+        }
+
+        void record(unsigned int timestep)
+        {
+            if(binary) {
+                const uint32_t timestep32 = timestep;
+                stream.write(reinterpret_cast<const char*>(&timestep32), sizeof(uint32_t));
+                stream.write(reinterpret_cast<const char*>(variable), sizeof(S) * popSize);
+            }
+            else {
+                for(unsigned int i = 0; i < popSize; i++) {
+                    stream << timestep << "," << i << "," << variable[i] << "\n";
+                }
+            }
+            nextTimestep = timestep + interval;
+        }
+
+        std::ofstream stream;
+        const S *variable;
+        const unsigned int popSize;
+        const unsigned int interval;
+        const bool binary;
+        unsigned int nextTimestep;
+    };
+
+    //----------------------------------------------------------------------------
+    // Private static methods
+    //----------------------------------------------------------------------------
+    static std::string toLower(std::string string)
+    {
+        std::transform(string.begin(), string.end(), string.begin(),
+                       [](unsigned char c){ return (char)std::tolower(c); });
+        return string;
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    const bool m_Binary;
+    unsigned int m_NextTimestep;
+    std::vector<Request> m_Requests;
+    std::vector<std::unique_ptr<Population>> m_Populations;
+};
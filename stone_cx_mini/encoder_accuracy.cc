@@ -0,0 +1,86 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Model includes
+#include "compass_encoder.h"
+#include "parameters.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+typedef float scalar;
+
+const unsigned int numAgents = 4096;
+const unsigned int numRepeats = 100;
+
+//! Time encoding a batch of agents numRepeats times, returning the time per agent [ns]
+template<typename F>
+double timeEncoding(F encodeFn)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for(unsigned int r = 0; r < numRepeats; r++) {
+        encodeFn();
+    }
+    const std::chrono::duration<double, std::nano> duration = std::chrono::high_resolution_clock::now() - start;
+    return duration.count() / (double)(numRepeats * numAgents);
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int numSamples = (argc > 1) ? std::atoi(argv[1]) : 100000;
+
+    // Generate random-ish agent states
+    std::vector<double> theta(numAgents);
+    std::vector<double> xVelocity(numAgents);
+    std::vector<double> yVelocity(numAgents);
+    for(unsigned int a = 0; a < numAgents; a++) {
+        theta[a] = 100.0 * sin((double)a);
+        xVelocity[a] = sin(0.7 * (double)a);
+        yVelocity[a] = cos(1.3 * (double)a);
+    }
+
+    std::vector<scalar> iDirTB1(numAgents * Parameters::numTB1);
+    std::vector<scalar> speedTN2(numAgents * Parameters::numTN2);
+
+    // Time analytic encoding, as previously performed in simulator.cc
+    const double analyticTime = timeEncoding(
+        [&]()
+        {
+            for(unsigned int a = 0; a < numAgents; a++) {
+                for(unsigned int j = 0; j < Parameters::numTN2; j++) {
+                    speedTN2[(a * Parameters::numTN2) + j] = (scalar)CompassEncoder<scalar>::getTN2Input(
+                        Parameters::preferredAngleTN2[j], theta[a], xVelocity[a], yVelocity[a]);
+                }
+                for(unsigned int j = 0; j < Parameters::numTB1; j++) {
+                    iDirTB1[(a * Parameters::numTB1) + j] = (scalar)CompassEncoder<scalar>::getTB1Input(
+                        Parameters::getPreferredAngleTB1(j, Parameters::numTB1), theta[a]);
+                }
+            }
+        });
+    std::cout << "Analytic encoding: " << analyticTime << "ns per agent" << std::endl;
+
+    std::cout << "Table size, Max TB1 error, Mean TB1 error, Max TN2 error, Mean TN2 error, Time per agent [ns]" << std::endl;
+    for(unsigned int tableSize = 64; tableSize <= 16384; tableSize *= 2) {
+        const CompassEncoder<scalar> encoder(Parameters::numTB1, tableSize);
+        const auto report = encoder.measureAccuracy(numSamples);
+
+        const double batchTime = timeEncoding(
+            [&]()
+            {
+                encoder.encodeBatch(numAgents, theta.data(), xVelocity.data(), yVelocity.data(),
+                                    iDirTB1.data(), speedTN2.data());
+            });
+
+        std::cout << tableSize << ", " << report.maxTB1Error << ", " << report.meanTB1Error << ", "
+            << report.maxTN2Error << ", " << report.meanTN2Error << ", " << batchTime << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <limits>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+
+// Model includes
+#include "connectivity.h"
+#include "parameters.h"
+
+//------------------------------------------------------------------------
+// FixedPoint
+//------------------------------------------------------------------------
+//! Helpers for the Q-format arithmetic used by FixedPointStep
+namespace FixedPoint
+{
+//! Activities, synaptic input and weights are stored in Q1.14 so [-2, 2) fits in an int16_t
+constexpr int activityFracBits = 14;
+constexpr int32_t activityOne = 1 << activityFracBits;
+
+//! Convert real value to fixed point with rounding
+inline int32_t fromReal(double x, int fracBits)
+{
+    return (int32_t)std::lround(std::ldexp(x, fracBits));
+}
+
+//! Convert fixed point value to real
+inline double toReal(int32_t x, int fracBits)
+{
+    return std::ldexp((double)x, -fracBits);
+}
+
+//! Convert non-negative real value to Q1.14 without any library calls
+inline int32_t activityFromReal(float x)
+{
+    return (int32_t)((x * (float)activityOne) + 0.5f);
+}
+
+//! Multiply two fixed point numbers, rounding result back into a's format
+//! **NOTE** product must fit in 31 bits
+inline int32_t multiply(int32_t a, int32_t b, int bFracBits)
+{
+    return ((a * b) + (1 << (bFracBits - 1))) >> bFracBits;
+}
+
+//! Rounding shift from one format to another
+inline int32_t convert(int32_t x, int fromFracBits, int toFracBits)
+{
+    return (fromFracBits > toFracBits) ? ((x + (1 << (fromFracBits - toFracBits - 1))) >> (fromFracBits - toFracBits))
+        : (x << (toFracBits - fromFracBits));
+}
+
+inline int32_t saturate(int32_t x, int32_t min, int32_t max)
+{
+    return std::min(max, std::max(x, min));
+}
+
+//------------------------------------------------------------------------
+// FixedPoint::SigmoidTable
+//------------------------------------------------------------------------
+//! Integer lookup table for 1 / (1 + exp(-((a * x) - b))).
+/*! Input x is in Q1.14 and the table covers [-4, 4) with 2^TableBits + 1 entries.
+    The low bits of the index are used to linearly interpolate between adjacent entries,
+    and input beyond the table's range takes the value at the nearest end. */
+template<unsigned int TableBits = 9>
+class SigmoidTable
+{
+public:
+    SigmoidTable(double a, double b)
+    {
+        for(unsigned int i = 0; i <= tableSize; i++) {
+            const double x = toReal(inputMin + (int32_t)(i << indexShift), activityFracBits);
+            m_Table[i] = (int16_t)fromReal(1.0 / (1.0 + std::exp(-((a * x) - b))), activityFracBits);
+        }
+    }
+
+    int16_t operator()(int32_t x) const
+    {
+        // Convert input into unsigned offset into table
+        const int32_t offset = saturate(x - inputMin, 0, inputRange - 1);
+        const int32_t index = offset >> indexShift;
+        const int32_t frac = offset & ((1 << indexShift) - 1);
+
+        // Linearly interpolate
+        const int32_t y0 = m_Table[index];
+        const int32_t y1 = m_Table[index + 1];
+        return (int16_t)(y0 + (((y1 - y0) * frac + (1 << (indexShift - 1))) >> indexShift));
+    }
+
+private:
+    static constexpr int32_t inputMin = -4 * activityOne;
+    static constexpr int32_t inputRange = 8 * activityOne;
+    static constexpr unsigned int tableSize = 1u << TableBits;
+    static constexpr int indexShift = (activityFracBits + 3) - (int)TableBits;
+
+    static_assert(indexShift > 0, "Sigmoid table can have at most one entry per input value");
+
+    int16_t m_Table[tableSize + 1];
+};
+
+//------------------------------------------------------------------------
+// Shared sigmoid tables
+//------------------------------------------------------------------------
+// **NOTE** tables only depend on the model's activation functions so one copy
+// is shared between every FixedPointStep rather than stored in each instance
+inline const SigmoidTable<> &getSigmoidTB1()
+{
+    static const SigmoidTable<> table(5.0, 0.0);
+    return table;
+}
+
+//! CPU4 and Pontine neurons share the same activation function
+inline const SigmoidTable<> &getSigmoidCPU4Pontine()
+{
+    static const SigmoidTable<> table(5.0, 2.5);
+    return table;
+}
+
+inline const SigmoidTable<> &getSigmoidCPU1()
+{
+    static const SigmoidTable<> table(7.5, -1.0);
+    return table;
+}
+}   // namespace FixedPoint
+
+//------------------------------------------------------------------------
+// FixedPointStep
+//------------------------------------------------------------------------
+//! Reduced-precision CPU implementation of the stone_cx model for small robot CPUs
+/*! All rates are stored as int16_t in Q1.14 and every sigmoid is evaluated with an integer
+    lookup table, shared between all instances, so the only floating point operations are converting the input and CPU1 output. The CPU4 memory, which integrates
+    tiny increments of h * (input - k) every timestep, is stored separately as MemoryType with
+    MemoryFracBits fractional bits and saturates at [0, 1]. As this is where precision matters
+    most, homing_precision sweeps this format to measure the degradation in homing.
+    The step() and getRCPU1() interface uses float, matching FusedStep<float, NumColumns>,
+    so the same compass encoder and homing harness can drive both models. */
+template<unsigned int NumColumns, typename MemoryType = uint16_t, unsigned int MemoryFracBits = 16>
+class FixedPointStep
+{
+public:
+    typedef float Scalar;
+
+    static constexpr unsigned int numTN2 = Parameters::HemisphereMax;
+    static constexpr unsigned int numTB1 = Connectivity::getHemisphereSize(NumColumns);
+    static constexpr unsigned int numCPU4 = NumColumns;
+    static constexpr unsigned int numPontine = NumColumns;
+    static constexpr unsigned int numCPU1 = NumColumns;
+
+    static_assert((NumColumns % 8) == 0, "CX model requires a multiple of 8 columns");
+    static_assert(MemoryFracBits >= 8 && MemoryFracBits <= 24, "CPU4 memory must have between 8 and 24 fractional bits");
+
+    FixedPointStep(const double *preferredAngleTB1)
+    {
+        // Quantise TB1->TB1 weights
+        for(unsigned int i = 0; i < numTB1; i++) {
+            for(unsigned int j = 0; j < numTB1; j++) {
+                m_GTB1TB1[(i * numTB1) + j] = (int16_t)FixedPoint::fromReal(
+                    Connectivity::getTB1TB1Weight(preferredAngleTB1[i], preferredAngleTB1[j], numTB1),
+                    FixedPoint::activityFracBits);
+            }
+        }
+
+        // Initialise state in same way as model.cc
+        std::fill_n(m_RTN2, numTN2, 0);
+        std::fill_n(m_RTB1, numTB1, 0);
+        std::fill_n(m_RCPU4, numCPU4, 0);
+        std::fill_n(m_ICPU4, numCPU4, (MemoryType)FixedPoint::fromReal(0.5, MemoryFracBits));
+        std::fill_n(m_RPontine, numPontine, 0);
+        std::fill_n(m_RCPU1, numCPU1, 0);
+        std::fill_n(m_RCPU1Output, numCPU1, 0.0f);
+    }
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Advance the model by one timestep
+    /*! As in FusedStep, populations are updated in reverse order so each
+        one reads the rates from the previous timestep. */
+    void step(const float *speedTN2, const float *iDirTB1)
+    {
+        using namespace FixedPoint;
+
+        const SigmoidTable<> &sigmoidTB1 = getSigmoidTB1();
+        const SigmoidTable<> &sigmoidCPU4Pontine = getSigmoidCPU4Pontine();
+        const SigmoidTable<> &sigmoidCPU1 = getSigmoidCPU1();
+
+        // CPU1 - weights of +-0.5 are applied with shifts
+        for(unsigned int i = 0; i < numCPU1; i++) {
+            const int32_t isyn = -(int32_t)m_RTB1[Connectivity::getTBToCPUSource(i, NumColumns)]
+                + ((int32_t)m_RCPU4[Connectivity::getCPU4ToCPU1Target(i, NumColumns)] >> 1)
+                - ((int32_t)m_RPontine[Connectivity::getPontineToCPU1Target(i, NumColumns)] >> 1);
+            m_RCPU1[i] = sigmoidCPU1(isyn);
+            m_RCPU1Output[i] = (float)m_RCPU1[i] * (1.0f / (float)activityOne);
+        }
+
+        // Pontine
+        for(unsigned int i = 0; i < numPontine; i++) {
+            m_RPontine[i] = sigmoidCPU4Pontine(m_RCPU4[i]);
+        }
+
+        // CPU4 - memory integrates with saturation
+        for(unsigned int i = 0; i < numCPU4; i++) {
+            const int32_t isyn = -(int32_t)m_RTB1[Connectivity::getTBToCPUSource(i, NumColumns)]
+                + (int32_t)m_RTN2[Connectivity::getTN2ToCPU4Source(i, NumColumns)];
+
+            const int32_t increment = multiply(saturate(isyn, 0, activityOne), memoryH, activityFracBits) - memoryHK;
+            const int32_t memory = saturate((int32_t)m_ICPU4[i] + increment, 0, memoryOne);
+            m_ICPU4[i] = (MemoryType)memory;
+            m_RCPU4[i] = sigmoidCPU4Pontine(convert(memory, MemoryFracBits, activityFracBits));
+        }
+
+        // TB1 is recurrently connected so gather all input before updating
+        int32_t isynTB1[numTB1];
+        for(unsigned int j = 0; j < numTB1; j++) {
+            isynTB1[j] = activityFromReal(iDirTB1[j]);
+        }
+        for(unsigned int i = 0; i < numTB1; i++) {
+            for(unsigned int j = 0; j < numTB1; j++) {
+                isynTB1[j] += multiply(m_GTB1TB1[(i * numTB1) + j], m_RTB1[i], activityFracBits);
+            }
+        }
+        for(unsigned int i = 0; i < numTB1; i++) {
+            m_RTB1[i] = sigmoidTB1(isynTB1[i]);
+        }
+
+        // TN2
+        for(unsigned int i = 0; i < numTN2; i++) {
+            m_RTN2[i] = (int16_t)activityFromReal(std::min(1.0f, std::max(speedTN2[i], 0.0f)));
+        }
+    }
+
+    //! CPU1 rates converted to float for steering
+    const float *getRCPU1() const{ return m_RCPU1Output; }
+
+    // Raw fixed point state
+    const int16_t *getRTN2Fixed() const{ return m_RTN2; }
+    const int16_t *getRTB1Fixed() const{ return m_RTB1; }
+    const int16_t *getRCPU4Fixed() const{ return m_RCPU4; }
+    const MemoryType *getICPU4Fixed() const{ return m_ICPU4; }
+    const int16_t *getRPontineFixed() const{ return m_RPontine; }
+    const int16_t *getRCPU1Fixed() const{ return m_RCPU1; }
+
+private:
+    //------------------------------------------------------------------------
+    // Static constants
+    //------------------------------------------------------------------------
+    // CPU4 memory parameters - must match model.cc
+    // **NOTE** if memory is stored in an unsigned type with all bits fractional, 1.0 saturates to the largest value
+    static constexpr int32_t memoryOne = (MemoryFracBits < std::numeric_limits<MemoryType>::digits)
+        ? (int32_t)(1u << MemoryFracBits) : (int32_t)std::numeric_limits<MemoryType>::max();
+    static constexpr int32_t memoryH = (int32_t)((0.0025 * (double)(1u << MemoryFracBits)) + 0.5);
+    static constexpr int32_t memoryHK = (int32_t)((0.0025 * 0.125 * (double)(1u << MemoryFracBits)) + 0.5);
+
+    static_assert(std::numeric_limits<MemoryType>::digits >= (int)MemoryFracBits, "CPU4 memory type is too small for format");
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    int16_t m_GTB1TB1[numTB1 * numTB1];
+
+    int16_t m_RTN2[numTN2];
+    int16_t m_RTB1[numTB1];
+    int16_t m_RCPU4[numCPU4];
+    MemoryType m_ICPU4[numCPU4];
+    int16_t m_RPontine[numPontine];
+    int16_t m_RCPU1[numCPU1];
+
+    float m_RCPU1Output[numCPU1];
+};
@@ -0,0 +1,276 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+
+// Standard C includes
+#include <cmath>
+#include <cstring>
+
+// Model includes
+#include "connectivity.h"
+#include "parameters.h"
+
+//------------------------------------------------------------------------
+// Unroll
+//------------------------------------------------------------------------
+//! Calls f(i) for i in [Begin, Begin + Count) with every index known at compile time.
+//! The range is split in half at each level so recursion depth is only log2(Count)
+template<unsigned int Begin, unsigned int Count>
+struct Unroll
+{
+    template<typename F>
+    static inline void apply(F &f)
+    {
+        Unroll<Begin, Count / 2>::apply(f);
+        Unroll<Begin + (Count / 2), Count - (Count / 2)>::apply(f);
+    }
+};
+
+template<unsigned int Begin>
+struct Unroll<Begin, 1>
+{
+    template<typename F>
+    static inline void apply(F &f)
+    {
+        f(Begin);
+    }
+};
+
+template<unsigned int Begin>
+struct Unroll<Begin, 0>
+{
+    template<typename F>
+    static inline void apply(F&)
+    {
+    }
+};
+
+//------------------------------------------------------------------------
+// FusedStep
+//------------------------------------------------------------------------
+//! Hand-fused CPU implementation of the stone_cx model with all connectivity
+//! resolved at compile time. All of the state lives in this object so, for
+//! the model sizes we use, a step never leaves L1 cache.
+/*! Replicates the order of floating point operations used by GeNN's generated
+    code so that, with VALIDATE_FUSED_STEP defined, it can be checked bit-for-bit
+    against stepTimeCPU(). As in GeNN, every population is updated using the
+    rates from the previous timestep. Rather than buffering synaptic input,
+    populations are therefore updated in reverse order (CPU1, Pontine, CPU4, TB1, TN2)
+    so each one only reads upstream rates which have not yet been overwritten. */
+template<typename S, unsigned int NumColumns>
+class FusedStep
+{
+public:
+    typedef S Scalar;
+
+    static constexpr unsigned int numTN2 = Parameters::HemisphereMax;
+    static constexpr unsigned int numTB1 = Connectivity::getHemisphereSize(NumColumns);
+    static constexpr unsigned int numCPU4 = NumColumns;
+    static constexpr unsigned int numPontine = NumColumns;
+    static constexpr unsigned int numCPU1 = NumColumns;
+
+    static_assert((NumColumns % 8) == 0, "CX model requires a multiple of 8 columns");
+
+    FusedStep(const double *preferredAngleTB1)
+    {
+        // Calculate TB1->TB1 weights in same way as buildConnectivity()
+        for(unsigned int i = 0; i < numTB1; i++) {
+            for(unsigned int j = 0; j < numTB1; j++) {
+                m_GTB1TB1[(i * numTB1) + j] = (S)Connectivity::getTB1TB1Weight(preferredAngleTB1[i], preferredAngleTB1[j], numTB1);
+            }
+        }
+
+        // Initialise state in same way as model.cc
+        std::fill_n(m_RTN2, numTN2, S(0.0));
+        std::fill_n(m_RTB1, numTB1, S(0.0));
+        std::fill_n(m_RCPU4, numCPU4, S(0.0));
+        std::fill_n(m_ICPU4, numCPU4, S(0.5));
+        std::fill_n(m_RPontine, numPontine, S(0.0));
+        std::fill_n(m_RCPU1, numCPU1, S(0.0));
+    }
+
+    //------------------------------------------------------------------------
+    // Public API
+    //------------------------------------------------------------------------
+    //! Advance the model by one timestep
+    void step(const S *speedTN2, const S *iDirTB1)
+    {
+        UpdateCPU1 updateCPU1(*this);
+        Unroll<0, numCPU1>::apply(updateCPU1);
+
+        UpdatePontine updatePontine(*this);
+        Unroll<0, numPontine>::apply(updatePontine);
+
+        UpdateCPU4 updateCPU4(*this);
+        Unroll<0, numCPU4>::apply(updateCPU4);
+
+        // TB1 is recurrently connected so gather all input before updating
+        S isynTB1[numTB1];
+        std::fill_n(isynTB1, numTB1, S(0.0));
+        AccumulateTB1 accumulateTB1(*this, isynTB1);
+        Unroll<0, numTB1>::apply(accumulateTB1);
+
+        UpdateTB1 updateTB1(*this, isynTB1, iDirTB1);
+        Unroll<0, numTB1>::apply(updateTB1);
+
+        UpdateTN2 updateTN2(*this, speedTN2);
+        Unroll<0, numTN2>::apply(updateTN2);
+    }
+
+    //! Compare state bit-for-bit against arrays updated by GeNN,
+    //! returning the number of neuron variables that differ
+    unsigned int countMismatches(const S *rTN2, const S *rTB1, const S *rCPU4, const S *iCPU4,
+                                 const S *rPontine, const S *rCPU1) const
+    {
+        return countMismatches(m_RTN2, rTN2, numTN2) + countMismatches(m_RTB1, rTB1, numTB1)
+            + countMismatches(m_RCPU4, rCPU4, numCPU4) + countMismatches(m_ICPU4, iCPU4, numCPU4)
+            + countMismatches(m_RPontine, rPontine, numPontine) + countMismatches(m_RCPU1, rCPU1, numCPU1);
+    }
+
+    const S *getRTN2() const{ return m_RTN2; }
+    const S *getRTB1() const{ return m_RTB1; }
+    const S *getRCPU4() const{ return m_RCPU4; }
+    const S *getICPU4() const{ return m_ICPU4; }
+    const S *getRPontine() const{ return m_RPontine; }
+    const S *getRCPU1() const{ return m_RCPU1; }
+
+private:
+    //------------------------------------------------------------------------
+    // Static helpers
+    //------------------------------------------------------------------------
+    static S sigmoid(S x, S a, S b)
+    {
+        return S(1.0) / (S(1.0) + std::exp(-((a * x) - b)));
+    }
+
+    static S clamp(S x)
+    {
+        return std::min(S(1.0), std::max(x, S(0.0)));
+    }
+
+    static unsigned int countMismatches(const S *a, const S *b, unsigned int n)
+    {
+        unsigned int numMismatches = 0;
+        for(unsigned int i = 0; i < n; i++) {
+            if(memcmp(&a[i], &b[i], sizeof(S)) != 0) {
+                numMismatches++;
+            }
+        }
+        return numMismatches;
+    }
+
+    //------------------------------------------------------------------------
+    // Per-neuron update functors
+    //------------------------------------------------------------------------
+    // **NOTE** parameters and weights must match model.cc and, to match GeNN, synaptic
+    // input is accumulated into Isyn in the order the synapse populations were added
+    struct UpdateCPU1
+    {
+        UpdateCPU1(FusedStep &s) : m_S(s){}
+
+        void operator()(unsigned int i)
+        {
+            S isyn = S(0.0);
+            isyn += S(-1.0) * m_S.m_RTB1[Connectivity::getTBToCPUSource(i, NumColumns)];
+            isyn += S(0.5) * m_S.m_RCPU4[Connectivity::getCPU4ToCPU1Target(i, NumColumns)];
+            isyn += S(-0.5) * m_S.m_RPontine[Connectivity::getPontineToCPU1Target(i, NumColumns)];
+            m_S.m_RCPU1[i] = sigmoid(isyn, S(7.5), S(-1.0));
+        }
+
+        FusedStep &m_S;
+    };
+
+    struct UpdatePontine
+    {
+        UpdatePontine(FusedStep &s) : m_S(s){}
+
+        void operator()(unsigned int i)
+        {
+            S isyn = S(0.0);
+            isyn += S(1.0) * m_S.m_RCPU4[i];
+            m_S.m_RPontine[i] = sigmoid(isyn, S(5.0), S(2.5));
+        }
+
+        FusedStep &m_S;
+    };
+
+    struct UpdateCPU4
+    {
+        UpdateCPU4(FusedStep &s) : m_S(s){}
+
+        void operator()(unsigned int i)
+        {
+            const S h = S(0.0025);
+            const S k = S(0.125);
+
+            S isyn = S(0.0);
+            isyn += S(-1.0) * m_S.m_RTB1[Connectivity::getTBToCPUSource(i, NumColumns)];
+            isyn += S(1.0) * m_S.m_RTN2[Connectivity::getTN2ToCPU4Source(i, NumColumns)];
+
+            S &iCPU4 = m_S.m_ICPU4[i];
+            iCPU4 += h * clamp(isyn);
+            iCPU4 -= h * k;
+            iCPU4 = clamp(iCPU4);
+            m_S.m_RCPU4[i] = sigmoid(iCPU4, S(5.0), S(2.5));
+        }
+
+        FusedStep &m_S;
+    };
+
+    struct AccumulateTB1
+    {
+        AccumulateTB1(FusedStep &s, S *isyn) : m_S(s), m_Isyn(isyn){}
+
+        void operator()(unsigned int i)
+        {
+            for(unsigned int j = 0; j < numTB1; j++) {
+                m_Isyn[j] += m_S.m_GTB1TB1[(i * numTB1) + j] * m_S.m_RTB1[i];
+            }
+        }
+
+        FusedStep &m_S;
+        S *m_Isyn;
+    };
+
+    struct UpdateTB1
+    {
+        UpdateTB1(FusedStep &s, const S *isyn, const S *iDir) : m_S(s), m_Isyn(isyn), m_IDir(iDir){}
+
+        void operator()(unsigned int i)
+        {
+            S isyn = S(0.0);
+            isyn += m_Isyn[i];
+            m_S.m_RTB1[i] = sigmoid(m_IDir[i] + isyn, S(5.0), S(0.0));
+        }
+
+        FusedStep &m_S;
+        const S *m_Isyn;
+        const S *m_IDir;
+    };
+
+    struct UpdateTN2
+    {
+        UpdateTN2(FusedStep &s, const S *speed) : m_S(s), m_Speed(speed){}
+
+        void operator()(unsigned int i)
+        {
+            m_S.m_RTN2[i] = clamp(m_Speed[i]);
+        }
+
+        FusedStep &m_S;
+        const S *m_Speed;
+    };
+
+    //------------------------------------------------------------------------
+    // Members
+    //------------------------------------------------------------------------
+    S m_GTB1TB1[numTB1 * numTB1];
+
+    S m_RTN2[numTN2];
+    S m_RTB1[numTB1];
+    S m_RCPU4[numCPU4];
+    S m_ICPU4[numCPU4];
+    S m_RPontine[numPontine];
+    S m_RCPU1[numCPU1];
+};
@@ -0,0 +1,36 @@
+// Standard C++ includes
+#include <iostream>
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+#include <cstdlib>
+
+// Model includes
+#include "outbound_route.h"
+#include "parameters.h"
+#include "philox.h"
+#include "route_bank.h"
+
+int main(int argc, char *argv[])
+{
+    if(argc < 3) {
+        std::cerr << "Usage: generate_routes <route bank filename> <number of routes> [seed]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const unsigned long long numRoutes = std::strtoull(argv[2], nullptr, 10);
+    const uint64_t seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1234;
+
+    RouteBankWriter writer(argv[1], Parameters::numOutwardTimesteps);
+    std::vector<AgentState> route(Parameters::numOutwardTimesteps);
+    for(unsigned long long r = 0; r < numRoutes; r++) {
+        // Generate each route from its own stream so any one can be regenerated from its index
+        Philox4x32 gen(seed, r);
+        generateOutboundRoute(gen, route.data());
+        writer.write(route.data());
+    }
+
+    std::cout << "Wrote " << numRoutes << " routes of " << Parameters::numOutwardTimesteps << " steps to " << argv[1] << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+// Standard C++ includes
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// Model includes
+#include "fixed_point_step.h"
+#include "fused_step.h"
+#include "homing_trial.h"
+#include "outbound_route.h"
+#include "parameters.h"
+#include "philox.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+//! Run every route through network, returning results
+template<typename Network>
+std::vector<HomingResult> runTrials(const std::vector<AgentState> &outboundRoutes, unsigned int numTrials,
+                                    const double *preferredAngleTB1)
+{
+    std::vector<HomingResult> results;
+    results.reserve(numTrials);
+    for(unsigned int t = 0; t < numTrials; t++) {
+        std::unique_ptr<Network> network(new Network(preferredAngleTB1));
+        results.push_back(runHomingTrial(*network, &outboundRoutes[t * Parameters::numOutwardTimesteps]));
+    }
+    return results;
+}
+
+//! Run trials with network and compare homing against float reference
+template<typename Network>
+void benchmark(const std::string &name, const std::vector<AgentState> &outboundRoutes, unsigned int numTrials,
+               const double *preferredAngleTB1, const std::vector<HomingResult> &reference)
+{
+    const auto results = runTrials<Network>(outboundRoutes, numTrials, preferredAngleTB1);
+
+    double totalStepTime = 0.0;
+    double totalRelativeError = 0.0;
+    double totalDegradation = 0.0;
+    double maxDegradation = 0.0;
+    unsigned int numFailures = 0;
+    for(unsigned int t = 0; t < numTrials; t++) {
+        const HomingResult &r = results[t];
+        totalStepTime += r.stepTime;
+
+        const double relativeError = r.closestDistance / r.outboundDistance;
+        totalRelativeError += relativeError;
+
+        // Degradation is increase in relative homing error over float model
+        const double degradation = relativeError - (reference[t].closestDistance / reference[t].outboundDistance);
+        totalDegradation += degradation;
+        maxDegradation = std::max(maxDegradation, degradation);
+
+        // Count trials where agent didn't get within 10% of outbound distance of nest
+        if(relativeError > 0.1) {
+            numFailures++;
+        }
+    }
+
+    // **NOTE** state is per-instance so excludes FixedPointStep's shared sigmoid tables
+    const unsigned int numSteps = numTrials * (Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps);
+    std::cout << name << ", " << sizeof(Network) << ", " << (totalStepTime * 1000000000.0) / (double)numSteps << ", "
+        << totalRelativeError / (double)numTrials << ", " << totalDegradation / (double)numTrials << ", "
+        << maxDegradation << ", " << numFailures << std::endl;
+}
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    constexpr unsigned int numColumns = Parameters::numColumns;
+
+    const unsigned int numTrials = (argc > 1) ? std::atoi(argv[1]) : 100;
+    const unsigned int seed = (argc > 2) ? std::atoi(argv[2]) : 1234;
+
+    double preferredAngleTB1[Parameters::numTB1];
+    for(unsigned int i = 0; i < Parameters::numTB1; i++) {
+        preferredAngleTB1[i] = Parameters::getPreferredAngleTB1(i, Parameters::numTB1);
+    }
+
+    // Generate routes up front so every model is tested on the same set of routes
+    std::vector<AgentState> outboundRoutes(numTrials * Parameters::numOutwardTimesteps);
+    for(unsigned int t = 0; t < numTrials; t++) {
+        Philox4x32 gen(seed, t);
+        generateOutboundRoute(gen, &outboundRoutes[t * Parameters::numOutwardTimesteps]);
+    }
+
+    // Run float model to get reference
+    typedef FusedStep<float, numColumns> Reference;
+    const auto reference = runTrials<Reference>(outboundRoutes, numTrials, preferredAngleTB1);
+
+    std::cout << "Model, State [bytes], Step time [ns], Relative homing error, Mean degradation, Max degradation, Failures" << std::endl;
+    benchmark<Reference>("float", outboundRoutes, numTrials, preferredAngleTB1, reference);
+    benchmark<FixedPointStep<numColumns, uint32_t, 24>>("Q14 + Q24 memory", outboundRoutes, numTrials, preferredAngleTB1, reference);
+    benchmark<FixedPointStep<numColumns, uint16_t, 16>>("Q14 + Q16 memory", outboundRoutes, numTrials, preferredAngleTB1, reference);
+    benchmark<FixedPointStep<numColumns, int16_t, 14>>("Q14 + Q14 memory", outboundRoutes, numTrials, preferredAngleTB1, reference);
+    benchmark<FixedPointStep<numColumns, uint16_t, 12>>("Q14 + Q12 memory", outboundRoutes, numTrials, preferredAngleTB1, reference);
+    benchmark<FixedPointStep<numColumns, uint16_t, 10>>("Q14 + Q10 memory", outboundRoutes, numTrials, preferredAngleTB1, reference);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+
+// Model includes
+#include "agent.h"
+#include "compass_encoder.h"
+#include "parameters.h"
+
+//----------------------------------------------------------------------------
+// HomingResult
+//----------------------------------------------------------------------------
+struct HomingResult
+{
+    // Straight-line distance from nest at end of outbound route
+    double outboundDistance;
+
+    // Closest the agent got to the nest while homing
+    double closestDistance;
+
+    // Total wall-clock time spent stepping the network [s]
+    double stepTime;
+};
+
+//----------------------------------------------------------------------------
+// Free functions
+//----------------------------------------------------------------------------
+//! Simulate timesteps [beginTimestep, endTimestep) of a trial, following outboundRoute
+//! for the first Parameters::numOutwardTimesteps and then path integrating home.
+/*! Network can be any of the CPU implementations of the CX model with a step(speedTN2, iDirTB1)
+    method and a getRCPU1() accessor. The agent dynamics are identical to simulator.cc. As all of
+    the trial's state lives in network, agent and result, trials can be forked part way through
+    by capturing these in a Snapshot. */
+template<typename Network>
+void runTrialSteps(Network &network, const CompassEncoder<typename Network::Scalar> &compassEncoder,
+                   const AgentState *outboundRoute, unsigned int beginTimestep, unsigned int endTimestep,
+                   double homingAcceleration, AgentState &agent, HomingResult &result)
+{
+    typedef typename Network::Scalar Scalar;
+
+    Scalar speedTN2[Parameters::numTN2];
+    std::vector<Scalar> iDirTB1(Network::numTB1);
+
+    std::chrono::high_resolution_clock::duration stepDuration(0);
+    for(unsigned int i = beginTimestep; i < endTimestep; i++) {
+        // Encode heading as TB1 input and project velocity onto each TN2 cell's preferred angle
+        compassEncoder.encode(agent.theta, agent.xVelocity, agent.yVelocity, iDirTB1.data(), speedTN2);
+
+        // Step network
+        const auto stepStart = std::chrono::high_resolution_clock::now();
+        network.step(speedTN2, iDirTB1.data());
+        stepDuration += (std::chrono::high_resolution_clock::now() - stepStart);
+
+        // Follow outbound route and then steer home using fixed acceleration
+        const bool outbound = (i < Parameters::numOutwardTimesteps);
+        if(outbound) {
+            agent = outboundRoute[i];
+        }
+        else {
+            updateAgent(agent, getHomingAngularVelocity(network.getRCPU1(), Network::numCPU1), homingAcceleration);
+        }
+
+        const double distance = std::sqrt((agent.xPosition * agent.xPosition) + (agent.yPosition * agent.yPosition));
+        if(outbound) {
+            result.outboundDistance = distance;
+        }
+        else {
+            result.closestDistance = std::min(result.closestDistance, distance);
+        }
+    }
+
+    result.stepTime += std::chrono::duration<double>(stepDuration).count();
+}
+
+//! Replay one outbound route and then path integrate home without any rendering or recording.
+/*! outboundRoute should contain Parameters::numOutwardTimesteps states e.g. from generateOutboundRoute or a RouteBank */
+template<typename Network>
+HomingResult runHomingTrial(Network &network, const AgentState *outboundRoute)
+{
+    const CompassEncoder<typename Network::Scalar> compassEncoder(Network::numTB1);
+
+    HomingResult result{0.0, std::numeric_limits<double>::max(), 0.0};
+    AgentState agent{0.0, 0.0, 0.0, 0.0, 0.0};
+    runTrialSteps(network, compassEncoder, outboundRoute, 0, Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps,
+                  0.1, agent, result);
+    return result;
+}
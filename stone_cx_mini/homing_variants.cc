@@ -0,0 +1,97 @@
+// Standard C++ includes
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// Standard C includes
+#include <cstdlib>
+
+// Common includes
+#include "../common/snapshot.h"
+
+// Model includes
+#include "fused_step.h"
+#include "homing_trial.h"
+#include "outbound_route.h"
+#include "parameters.h"
+#include "philox.h"
+
+//---------------------------------------------------------------------------
+// Anonymous namespace
+//---------------------------------------------------------------------------
+namespace
+{
+typedef float scalar;
+typedef FusedStep<scalar, Parameters::numColumns> Network;
+
+const double homingAccelerations[] = {0.025, 0.05, 0.075, 0.1, 0.125, 0.15, 0.175, 0.2};
+}   // Anonymous namespace
+
+int main(int argc, char *argv[])
+{
+    const unsigned int seed = (argc > 1) ? std::atoi(argv[1]) : 1234;
+
+    double preferredAngleTB1[Parameters::numTB1];
+    for(unsigned int i = 0; i < Parameters::numTB1; i++) {
+        preferredAngleTB1[i] = Parameters::getPreferredAngleTB1(i, Parameters::numTB1);
+    }
+
+    std::vector<AgentState> outboundRoute(Parameters::numOutwardTimesteps);
+    Philox4x32 gen(seed, 0);
+    generateOutboundRoute(gen, outboundRoute.data());
+
+    const CompassEncoder<scalar> compassEncoder(Parameters::numTB1);
+
+    // Register all trial state with snapshot
+    Network network(preferredAngleTB1);
+    AgentState agent{0.0, 0.0, 0.0, 0.0, 0.0};
+    HomingResult result{0.0, std::numeric_limits<double>::max(), 0.0};
+    Snapshot snapshot;
+    snapshot.addVariable(&network);
+    snapshot.addVariable(&agent);
+    snapshot.addVariable(&result);
+
+    // Run outbound route once and capture state
+    const auto outboundStart = std::chrono::high_resolution_clock::now();
+    runTrialSteps(network, compassEncoder, outboundRoute.data(), 0, Parameters::numOutwardTimesteps,
+                  0.0, agent, result);
+    const std::chrono::duration<double, std::micro> outboundDuration = std::chrono::high_resolution_clock::now() - outboundStart;
+
+    const auto captureStart = std::chrono::high_resolution_clock::now();
+    snapshot.capture();
+    const std::chrono::duration<double, std::micro> captureDuration = std::chrono::high_resolution_clock::now() - captureStart;
+
+    std::cout << "Outbound phase: " << outboundDuration.count() << "us, snapshot capture: " << captureDuration.count()
+        << "us (" << snapshot.getSize() << " bytes)" << std::endl;
+
+    // Fork homing variants from outbound state
+    std::cout << "Homing acceleration, Restore time [us], Homing time [us], Outbound distance, Closest distance" << std::endl;
+    for(double homingAcceleration : homingAccelerations) {
+        const auto restoreStart = std::chrono::high_resolution_clock::now();
+        snapshot.restore();
+        const std::chrono::duration<double, std::micro> restoreDuration = std::chrono::high_resolution_clock::now() - restoreStart;
+
+        const auto homingStart = std::chrono::high_resolution_clock::now();
+        runTrialSteps(network, compassEncoder, outboundRoute.data(),
+                      Parameters::numOutwardTimesteps, Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps,
+                      homingAcceleration, agent, result);
+        const std::chrono::duration<double, std::micro> homingDuration = std::chrono::high_resolution_clock::now() - homingStart;
+
+        std::cout << homingAcceleration << ", " << restoreDuration.count() << ", " << homingDuration.count() << ", "
+            << result.outboundDistance << ", " << result.closestDistance << std::endl;
+    }
+
+    // Check forking is exact by comparing the default variant against an uninterrupted trial
+    Network referenceNetwork(preferredAngleTB1);
+    const HomingResult referenceResult = runHomingTrial(referenceNetwork, outboundRoute.data());
+    snapshot.restore();
+    runTrialSteps(network, compassEncoder, outboundRoute.data(),
+                  Parameters::numOutwardTimesteps, Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps,
+                  0.1, agent, result);
+    if(result.closestDistance != referenceResult.closestDistance) {
+        std::cerr << "Forked trial diverged from uninterrupted trial" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+// Standard C++ includes
+#include <vector>
+
+// Standard C includes
+#include <cstdint>
+
+// Model includes
+#include "agent.h"
+#include "batch_von_mises.h"
+#include "parameters.h"
+#include "philox.h"
+#include "uniform_spline.h"
+
+//----------------------------------------------------------------------------
+// Free functions
+//----------------------------------------------------------------------------
+//! Generate a random outbound route, writing the agent's state after each
+//! of the Parameters::numOutwardTimesteps outbound timesteps to route.
+//! With a counter-based generator, e.g. Philox4x32(seed, routeIndex), every route is bit-reproducible
+template<typename Generator>
+void generateOutboundRoute(Generator &gen, AgentState *route)
+{
+    // Create acceleration spline and evaluate at each outbound timestep
+    std::vector<double> outboundAcceleration(Parameters::numOutwardTimesteps);
+    {
+        // Create vector to hold the values linear acceleration should
+        // change to every accelerationChangeInterval timesteps
+        const unsigned int numAccelerationChanges = Parameters::numOutwardTimesteps / Parameters::accelerationChangeInterval;
+        std::vector<double> accelerationMagnitude(numAccelerationChanges);
+
+        // Draw accelerations from uniform distribution
+        std::vector<uint32_t> accelerationBits(numAccelerationChanges);
+        fillRandomBits(gen, accelerationBits.data(), numAccelerationChanges);
+        for(unsigned int i = 0; i < numAccelerationChanges; i++) {
+            accelerationMagnitude[i] = Parameters::agentMinAcceleration
+                + ((Parameters::agentMaxAcceleration - Parameters::agentMinAcceleration) * toUniform(accelerationBits[i]));
+        }
+
+        // Build spline from these and evaluate
+        const UniformSpline accelerationSpline(0.0, (double)Parameters::accelerationChangeInterval, accelerationMagnitude);
+        accelerationSpline.evaluate(0.0, 1.0, Parameters::numOutwardTimesteps, outboundAcceleration.data());
+    }
+
+    // Sample angular acceleration for every outbound timestep from Von Mises distribution
+    std::vector<double> angularAcceleration(Parameters::numOutwardTimesteps);
+    BatchVonMisesDistribution<double> pathVonMises(0.0, Parameters::pathKappa);
+    pathVonMises.fill(gen, angularAcceleration.data(), Parameters::numOutwardTimesteps);
+
+    AgentState state{0.0, 0.0, 0.0, 0.0, 0.0};
+    double omega = 0.0;
+    for(unsigned int i = 0; i < Parameters::numOutwardTimesteps; i++) {
+        // Update angular velocity
+        omega = (Parameters::pathLambda * omega) + angularAcceleration[i];
+
+        // Update agent using linear acceleration read off spline
+        updateAgent(state, omega, outboundAcceleration[i]);
+        route[i] = state;
+    }
+}
@@ -5,23 +5,54 @@
 //------------------------------------------------------------------------
 namespace Parameters
 {
+    // Number of columns (split evenly between hemispheres) in CPU4, Pontine and CPU1
+    const unsigned int numColumns = 8;
+
     // Population sizes
     const unsigned int numTN2 = 2;
-    const unsigned int numTL = 8;
-    const unsigned int numCL1 = 8;
-    const unsigned int numTB1 = 4;
-    const unsigned int numCPU4 = 8;
-    const unsigned int numPontine = 8;
-    const unsigned int numCPU1 = 8;
+    const unsigned int numTL = numColumns;
+    const unsigned int numCL1 = numColumns;
+    const unsigned int numTB1 = numColumns / 2;
+    const unsigned int numCPU4 = numColumns;
+    const unsigned int numPontine = numColumns;
+    const unsigned int numCPU1 = numColumns;
 
     const double c = 0.33;
 
     const double pi = 3.141592653589793238462643383279502884;
-    
+
+    // Outbound path generation parameters
+    const unsigned int numOutwardTimesteps = 1500;
+    const unsigned int numInwardTimesteps = 1500;
+
+    // How often (in timesteps) the spline defining outbound acceleration has a knot
+    const unsigned int accelerationChangeInterval = 50;
+
+    // Agent dynamics parameters
+    const double pathLambda = 0.4;
+    const double pathKappa = 100.0;
+
+    const double agentDrag = 0.15;
+
+    const double agentMinAcceleration = 0.0;
+    const double agentMaxAcceleration = 0.15;
+    const double agentM = 0.5;
+
+    // Hemisphere size the original model was tuned for - TB1 inhibition and motor output are scaled relative to this
+    const double referenceHemisphereSize = 4.0;
+
+    const double preferredAngleTN2[] = { pi * 0.25, -pi * 0.25 };
+
     enum Hemisphere
     {
         HemisphereLeft,
         HemisphereRight,
         HemisphereMax,
-    };  
-}
\ No newline at end of file
+    };
+
+    //! TB1 neurons' preferred headings are spread evenly around the circle
+    inline double getPreferredAngleTB1(unsigned int i, unsigned int numTB1Neurons)
+    {
+        return 2.0 * pi * (double)i / (double)numTB1Neurons;
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+// Standard C++ includes
+#include <limits>
+
+// Standard C includes
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------------
+// Philox4x32
+//----------------------------------------------------------------------------
+//! Counter-based Philox4x32-10 random number generator (Salmon et al. 2011)
+/*! Each 128-bit output block is a pure function of a 64-bit key (the seed) and a 128-bit counter.
+    The upper 64 bits of the counter hold the stream index and the lower 64 bits the block index
+    within the stream so, unlike std::mt19937, a generator is 48 bytes (including one buffered block of
+    output), creating a generator for any stream is O(1) and so is skipping ahead with discard(). This means every trial or agent can
+    have its own independent, reproducible stream. Satisfies UniformRandomBitGenerator so can be used
+    with the standard distributions. */
+class Philox4x32
+{
+public:
+    typedef uint32_t result_type;
+
+    Philox4x32(uint64_t seed = 0, uint64_t stream = 0)
+    :   m_Seed(seed), m_Stream(stream), m_Position(0), m_BufferedBlock(std::numeric_limits<uint64_t>::max())
+    {
+    }
+
+    //----------------------------------------------------------------------------
+    // Static API
+    //----------------------------------------------------------------------------
+    static constexpr result_type min(){ return 0; }
+    static constexpr result_type max(){ return std::numeric_limits<result_type>::max(); }
+
+    //! Generate the block of four outputs for block index in stream of generator with seed
+    static void generateBlock(uint64_t seed, uint64_t stream, uint64_t block, uint32_t output[4])
+    {
+        uint32_t c0 = (uint32_t)block;
+        uint32_t c1 = (uint32_t)(block >> 32);
+        uint32_t c2 = (uint32_t)stream;
+        uint32_t c3 = (uint32_t)(stream >> 32);
+        uint32_t k0 = (uint32_t)seed;
+        uint32_t k1 = (uint32_t)(seed >> 32);
+
+        for(unsigned int r = 0; r < 10; r++) {
+            // Multiply
+            const uint64_t product0 = (uint64_t)multiplier0 * c0;
+            const uint64_t product1 = (uint64_t)multiplier1 * c2;
+
+            // Permute and mix in key
+            c0 = (uint32_t)(product1 >> 32) ^ c1 ^ k0;
+            c1 = (uint32_t)product1;
+            c2 = (uint32_t)(product0 >> 32) ^ c3 ^ k1;
+            c3 = (uint32_t)product0;
+
+            // Bump key
+            k0 += weyl0;
+            k1 += weyl1;
+        }
+
+        output[0] = c0;
+        output[1] = c1;
+        output[2] = c2;
+        output[3] = c3;
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    result_type operator()()
+    {
+        // If block containing current position isn't buffered, generate it
+        const uint64_t block = m_Position >> 2;
+        if(block != m_BufferedBlock) {
+            generateBlock(m_Seed, m_Stream, block, m_Buffer);
+            m_BufferedBlock = block;
+        }
+        return m_Buffer[m_Position++ & 3];
+    }
+
+    //! Skip ahead n outputs in O(1)
+    void discard(unsigned long long n)
+    {
+        m_Position += n;
+    }
+
+    //! Fill output with the next n outputs - equivalent to calling operator() n times but,
+    //! as blocks are independent, the inner loop can be vectorised
+    void fill(uint32_t *output, size_t n)
+    {
+        // Use up any buffered outputs
+        while(n > 0 && (m_Position & 3) != 0) {
+            *output++ = (*this)();
+            n--;
+        }
+
+        // Generate whole blocks directly into output
+        const uint64_t firstBlock = m_Position >> 2;
+        const size_t numBlocks = n / 4;
+        for(size_t b = 0; b < numBlocks; b++) {
+            generateBlock(m_Seed, m_Stream, firstBlock + b, &output[b * 4]);
+        }
+        m_Position += numBlocks * 4;
+
+        // Generate remainder
+        for(size_t i = numBlocks * 4; i < n; i++) {
+            output[i] = (*this)();
+        }
+    }
+
+    //! Get a generator for another stream with the same seed
+    Philox4x32 getStream(uint64_t stream) const
+    {
+        return Philox4x32(m_Seed, stream);
+    }
+
+    uint64_t getSeed() const{ return m_Seed; }
+    uint64_t getStream() const{ return m_Stream; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Static constants
+    //----------------------------------------------------------------------------
+    static constexpr uint32_t multiplier0 = 0xD2511F53;
+    static constexpr uint32_t multiplier1 = 0xCD9E8D57;
+    static constexpr uint32_t weyl0 = 0x9E3779B9;
+    static constexpr uint32_t weyl1 = 0xBB67AE85;
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    uint64_t m_Seed;
+    uint64_t m_Stream;
+    uint64_t m_Position;
+    uint64_t m_BufferedBlock;
+    uint32_t m_Buffer[4];
+};
+
+//----------------------------------------------------------------------------
+// Free functions
+//----------------------------------------------------------------------------
+//! Fill output with n raw outputs from any 32-bit UniformRandomBitGenerator
+template<typename Generator>
+void fillRandomBits(Generator &gen, uint32_t *output, size_t n)
+{
+    for(size_t i = 0; i < n; i++) {
+        output[i] = (uint32_t)gen();
+    }
+}
+
+//! Philox4x32 can generate whole blocks at once
+inline void fillRandomBits(Philox4x32 &gen, uint32_t *output, size_t n)
+{
+    gen.fill(output, n);
+}
+
+//! Convert 32 random bits to a double uniformly distributed in (0, 1).
+/*! Unlike std::uniform_real_distribution, the result is the same on every standard library */
+inline double toUniform(uint32_t bits)
+{
+    return ((double)bits + 0.5) * (1.0 / 4294967296.0);
+}
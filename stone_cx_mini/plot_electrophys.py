@@ -1,53 +1,60 @@
-import csv
+import os
 import matplotlib.pyplot as plt
 import numpy as np
 
 def load_csv(filename):
-    with open(filename, "rb") as csv_file:
-        csv_reader = csv.reader(csv_file, delimiter = ",")
-
-        # Skip headers
-        csv_reader.next()
-
-        # Read data and zip into columns
-        data_columns = zip(*csv_reader)
-
-        # Convert CSV columns to numpy
-        neuron_id = np.asarray(data_columns[1], dtype=int)
-        value = np.asarray(data_columns[2], dtype=float)
-
-        # Reshape value into 2D array and transpose
-        value = np.reshape(value, (-1, len(np.unique(neuron_id))))
-        return np.transpose(value)
-
-
-tn2 = load_csv("tn2.csv")
-cl1 = load_csv("cl1.csv")
-tb1 = load_csv("tb1.csv")
-cpu4 = load_csv("cpu4.csv")
-cpu1 = load_csv("cpu1.csv")
-
-fig, axes = plt.subplots(5, sharex=True)
-
-# Labels
-axes[0].set_ylabel("TN2\n(speed)")
-axes[1].set_ylabel("CL1")
-axes[1].set_yticks([0, 7, 15])
-axes[2].set_ylabel("TB1")
-axes[1].set_yticks([0, 7])
-axes[3].set_ylabel("CPU4")
-axes[1].set_yticks([0, 7, 15])
-axes[4].set_ylabel("CPU1")
-axes[1].set_yticks([0, 7, 15])
-axes[4].set_xlabel("Time [steps]")
+    # Read time, neuron ID and value columns, skipping headers
+    data = np.loadtxt(filename, delimiter=",", skiprows=1, ndmin=2)
+    neuron_id = data[:,1].astype(int)
+    pop_size = len(np.unique(neuron_id))
+
+    # Reshape value into 2D array and transpose
+    time = data[::pop_size,0]
+    value = np.reshape(data[:,2], (-1, pop_size))
+    return time, np.transpose(value)
+
+def load_binary(filename):
+    with open(filename, "rb") as binary_file:
+        # Check magic and read header
+        assert binary_file.read(8) == b"CXRECORD"
+        pop_size, scalar_size = np.fromfile(binary_file, dtype=np.uint32, count=2)
+        scalar_type = np.float32 if scalar_size == 4 else np.float64
+
+        # Read records consisting of timestep followed by population's values
+        record_type = np.dtype([("time", np.uint32), ("value", scalar_type, (pop_size,))])
+        records = np.fromfile(binary_file, dtype=record_type)
+        return records["time"], np.transpose(records["value"])
+
+def load(name):
+    # Load whichever format was recorded
+    if os.path.exists(name + ".bin"):
+        return load_binary(name + ".bin")
+    elif os.path.exists(name + ".csv"):
+        return load_csv(name + ".csv")
+    else:
+        return None
+
+# Load all populations which were recorded
+populations = [("tn2", "TN2\n(speed)"), ("tb1", "TB1"), ("cpu4", "CPU4"),
+               ("cpu4memory", "CPU4\nmemory"), ("pontine", "Pontine"), ("cpu1", "CPU1")]
+recordings = [(label, load(name)) for name, label in populations]
+recordings = [(label, data) for label, data in recordings if data is not None]
+
+fig, axes = plt.subplots(len(recordings), sharex=True, squeeze=False)
+axes = axes[:,0]
 
 # Plot
 interp = "nearest"
-axes[0].plot(tn2[0,])
-axes[0].plot(tn2[1,])
-axes[1].imshow(cl1, aspect="auto", interpolation=interp, origin="lower", vmin=0.0, vmax=1.0)
-axes[2].imshow(tb1, aspect="auto", interpolation=interp, origin="lower", vmin=0.0, vmax=1.0)
-axes[3].imshow(cpu4, aspect="auto", interpolation=interp, origin="lower", vmin=0.0, vmax=1.0)
-axes[4].imshow(cpu1, aspect="auto", interpolation=interp, origin="lower", vmin=0.0, vmax=1.0)
-
-plt.show()
\ No newline at end of file
+for axis, (label, (time, value)) in zip(axes, recordings):
+    axis.set_ylabel(label)
+
+    # Plot small populations (i.e. TN2) as lines and others as images
+    if value.shape[0] <= 2:
+        for v in value:
+            axis.plot(time, v)
+    else:
+        axis.imshow(value, aspect="auto", interpolation=interp, origin="lower",
+                    extent=(time[0], time[-1], -0.5, value.shape[0] - 0.5))
+
+axes[-1].set_xlabel("Time [steps]")
+plt.show()
@@ -0,0 +1,190 @@
+#pragma once
+
+// Standard C++ includes
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// Standard C includes
+#include <cstdint>
+#include <cstring>
+
+// POSIX includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Model includes
+#include "agent.h"
+
+//----------------------------------------------------------------------------
+// RouteBankHeader
+//----------------------------------------------------------------------------
+//! Header at the start of route bank files. Routes follow immediately
+//! afterwards, each one numSteps contiguous AgentStates
+struct RouteBankHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numSteps;
+    uint64_t numRoutes;
+
+    static constexpr const char *magicString = "CXROUTES";
+    static constexpr uint32_t currentVersion = 1;
+};
+
+//----------------------------------------------------------------------------
+// RouteBankWriter
+//----------------------------------------------------------------------------
+//! Streams routes into a route bank file
+class RouteBankWriter
+{
+public:
+    RouteBankWriter(const std::string &filename, unsigned int numSteps)
+    :   m_Stream(filename, std::ios::binary), m_NumSteps(numSteps), m_NumRoutes(0)
+    {
+        if(!m_Stream.good()) {
+            throw std::runtime_error("Cannot open route bank '" + filename + "' for writing");
+        }
+
+        // Write header - number of routes is filled in when writer is destroyed
+        writeHeader();
+    }
+
+    ~RouteBankWriter()
+    {
+        // Rewind and update header with final route count
+        m_Stream.seekp(0);
+        writeHeader();
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Append a route consisting of getNumSteps() states
+    void write(const AgentState *route)
+    {
+        m_Stream.write(reinterpret_cast<const char*>(route), sizeof(AgentState) * m_NumSteps);
+        if(!m_Stream.good()) {
+            throw std::runtime_error("Error writing route bank");
+        }
+        m_NumRoutes++;
+    }
+
+    unsigned int getNumSteps() const{ return m_NumSteps; }
+    uint64_t getNumRoutes() const{ return m_NumRoutes; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    void writeHeader()
+    {
+        RouteBankHeader header;
+        memcpy(header.magic, RouteBankHeader::magicString, sizeof(header.magic));
+        header.version = RouteBankHeader::currentVersion;
+        header.numSteps = m_NumSteps;
+        header.numRoutes = m_NumRoutes;
+        m_Stream.write(reinterpret_cast<const char*>(&header), sizeof(RouteBankHeader));
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    std::ofstream m_Stream;
+    const unsigned int m_NumSteps;
+    uint64_t m_NumRoutes;
+};
+
+//----------------------------------------------------------------------------
+// RouteBank
+//----------------------------------------------------------------------------
+//! Read-only, memory-mapped view of a route bank file.
+/*! Routes are paged in by the OS as they are accessed so replaying a single route
+    from a bank of millions only touches the pages containing that route. */
+class RouteBank
+{
+public:
+    RouteBank(const std::string &filename) : m_Data(nullptr), m_Size(0)
+    {
+        // Open file and get its size
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if(fd == -1) {
+            throw std::runtime_error("Cannot open route bank '" + filename + "'");
+        }
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == -1) {
+            close(fd);
+            throw std::runtime_error("Cannot stat route bank '" + filename + "'");
+        }
+        m_Size = (size_t)fileStat.st_size;
+        if(m_Size < sizeof(RouteBankHeader)) {
+            close(fd);
+            throw std::runtime_error("Route bank '" + filename + "' is too small to contain header");
+        }
+
+        // Map file - the mapping remains valid after the file descriptor is closed
+        m_Data = mmap(nullptr, m_Size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(m_Data == MAP_FAILED) {
+            m_Data = nullptr;
+            throw std::runtime_error("Cannot memory map route bank '" + filename + "'");
+        }
+
+        // Validate header
+        const RouteBankHeader *header = getHeader();
+        if(memcmp(header->magic, RouteBankHeader::magicString, sizeof(header->magic)) != 0
+            || header->version != RouteBankHeader::currentVersion)
+        {
+            munmap(m_Data, m_Size);
+            throw std::runtime_error("'" + filename + "' is not a compatible route bank");
+        }
+        // **NOTE** divide space after header rather than multiplying so corrupt route counts can't overflow
+        const uint64_t routeBytes = (uint64_t)header->numSteps * sizeof(AgentState);
+        if(routeBytes > 0 && header->numRoutes > ((m_Size - sizeof(RouteBankHeader)) / routeBytes)) {
+            munmap(m_Data, m_Size);
+            throw std::runtime_error("Route bank '" + filename + "' is truncated");
+        }
+    }
+
+    ~RouteBank()
+    {
+        if(m_Data != nullptr) {
+            munmap(m_Data, m_Size);
+        }
+    }
+
+    RouteBank(const RouteBank&) = delete;
+    RouteBank &operator=(const RouteBank&) = delete;
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Get pointer to getNumSteps() states making up route
+    const AgentState *getRoute(uint64_t route) const
+    {
+        if(route >= getNumRoutes()) {
+            throw std::runtime_error("Route " + std::to_string(route) + " is not in route bank of "
+                                     + std::to_string(getNumRoutes()) + " routes");
+        }
+
+        const AgentState *routes = reinterpret_cast<const AgentState*>(getHeader() + 1);
+        return &routes[route * getNumSteps()];
+    }
+
+    unsigned int getNumSteps() const{ return getHeader()->numSteps; }
+    uint64_t getNumRoutes() const{ return getHeader()->numRoutes; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    const RouteBankHeader *getHeader() const{ return reinterpret_cast<const RouteBankHeader*>(m_Data); }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    void *m_Data;
+    size_t m_Size;
+};
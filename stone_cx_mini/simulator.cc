@@ -1,261 +1,262 @@
 // Standard C++ includes
 #include <iostream>
-#include <numeric>
+#include <memory>
 #include <random>
+#include <string>
 #include <vector>
 
 // Standard C includes
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 
 // OpenCV includes
 #include <opencv2/opencv.hpp>
 
-// GeNN robotics includes
-#include "analogue_csv_recorder.h"
-#include "von_mises_distribution.h"
+// Common includes
+#include "../common/snapshot.h"
 
 // GeNN generated code includes
 #include "stone_cx_CODE/definitions.h"
 
 // Model includes
+#include "activity_renderer.h"
+#include "agent.h"
+#include "compass_encoder.h"
+#include "electrophys_recorder.h"
+#include "fused_step.h"
+#include "outbound_route.h"
 #include "parameters.h"
+#include "philox.h"
+#include "route_bank.h"
 #include "simulatorCommon.h"
-#include "spline.h"
 
-//---------------------------------------------------------------------------
-// Anonymous namespace
-//---------------------------------------------------------------------------
-namespace
-{
-
-template<typename F>
-void drawNeuronActivity(scalar activity, const cv::Point &position, F getColourFn, cv::Mat &image)
-{
-    // Convert activity to a 8-bit level
-    const unsigned char gray = (unsigned char)(255.0f * std::min(1.0f, std::max(0.0f, activity)));
-
-    // Draw rectangle of this colour
-    cv::rectangle(image, position, position + cv::Point(25, 25), getColourFn(gray), cv::FILLED);
-}
+#if defined(FUSED_STEP) && defined(VALIDATE_FUSED_STEP)
+    #error "VALIDATE_FUSED_STEP validates the fused step against GeNN so cannot be combined with FUSED_STEP"
+#endif
 
-template<typename F>
-void drawPopulationActivity(scalar *popActivity, int popSize, const char *popName,
-                            const cv::Point &position, F getColourFn, cv::Mat &image, int numColumns=0)
+int main(int argc, char *argv[])
 {
-    // If (invalid) default number of columns is specified, use popsize
-    if(numColumns == 0) {
-        numColumns = popSize;
+    // Parse command line options, leaving any positional arguments in positionalArgs
+    std::string recordSpecification;
+    bool recordBinary = false;
+    double renderFPS = 30.0;
+    bool display = true;
+    std::string videoFilename;
+    std::string saveStateFilename;
+    std::string loadStateFilename;
+    bool seedSpecified = false;
+    uint64_t seed = 0;
+    bool printConnectivity = false;
+    std::string connectivityCacheFilename;
+    std::vector<const char*> positionalArgs;
+    for(int a = 1; a < argc; a++) {
+        const std::string arg = argv[a];
+        if(arg == "--record" && (a + 1) < argc) {
+            recordSpecification = argv[++a];
+        }
+        else if(arg == "--record-binary") {
+            recordBinary = true;
+        }
+        else if(arg == "--fps" && (a + 1) < argc) {
+            renderFPS = std::atof(argv[++a]);
+        }
+        else if(arg == "--video" && (a + 1) < argc) {
+            videoFilename = argv[++a];
+        }
+        else if(arg == "--headless") {
+            display = false;
+        }
+        else if(arg == "--save-state" && (a + 1) < argc) {
+            saveStateFilename = argv[++a];
+        }
+        else if(arg == "--load-state" && (a + 1) < argc) {
+            loadStateFilename = argv[++a];
+        }
+        else if(arg == "--seed" && (a + 1) < argc) {
+            seed = std::strtoull(argv[++a], nullptr, 10);
+            seedSpecified = true;
+        }
+        else if(arg == "--print-connectivity") {
+            printConnectivity = true;
+        }
+        else if(arg == "--connectivity-cache" && (a + 1) < argc) {
+            connectivityCacheFilename = argv[++a];
+        }
+        else if(arg.compare(0, 2, "--") == 0) {
+            std::cerr << "Usage: simulator [--record POP[:INTERVAL][,POP[:INTERVAL]...]] [--record-binary] [--fps FPS] [--video FILENAME] [--headless] [--save-state FILENAME] [--load-state FILENAME] [--seed SEED] [--print-connectivity] [--connectivity-cache FILENAME] [route bank filename route index]" << std::endl;
+            return EXIT_FAILURE;
+        }
+        else {
+            positionalArgs.push_back(argv[a]);
+        }
     }
 
-    // Loop through each neuron in population
-    for(int i = 0; i < popSize; i++) {
-        // Calculate coordinate in terms of rows and columns
-        auto coord = std::div(i, numColumns);
-        cv::Point offset(coord.rem * 27, coord.quot * 27);
-
-        // Draw neuron activity
-        drawNeuronActivity(popActivity[i], position + offset, getColourFn, image);
+    double preferredAngleTB1[Parameters::numTB1];
+    for(unsigned int i = 0; i < Parameters::numTB1; i++) {
+        preferredAngleTB1[i] = Parameters::getPreferredAngleTB1(i, Parameters::numTB1);
     }
 
-    // Label population
-    const int numRows = (int)ceil((double)popSize / (double)numColumns);
-    cv::putText(image, popName, position + cv::Point(0, 17 + (27 * numRows)),
-                cv::FONT_HERSHEY_COMPLEX_SMALL, 1.0, CV_RGB(0xFF, 0xFF, 0xFF));
-}
-
-cv::Scalar getReds(unsigned char gray)
-{
-    return CV_RGB(gray, 0, 0);
-}
-
-cv::Scalar getGreens(unsigned char gray)
-{
-    return CV_RGB(0, gray, 0);
-}
-
-cv::Scalar getBlues(unsigned char gray)
-{
-    return CV_RGB(0, 0, gray);
-}
-}   // Anonymous namespace
-
-int main()
-{
-    // Simulation rendering parameters
-    const unsigned int pathImageSize = 1000;
-    const unsigned int activityImageWidth = 500;
-    const unsigned int activityImageHeight = 500;
-    
-    const double preferredAngleTN2[] = { Parameters::pi * 0.25, -Parameters::pi * 0.25 };
-    const double preferredAngleTB1[] = { 0.0, Parameters::pi * 0.5, Parameters::pi, Parameters::pi * 1.5 };
-    
-    // Outbound path generation parameters
-    const unsigned int numOutwardTimesteps = 1500;
-    const unsigned int numInwardTimesteps = 1500;
-
-    // Agent dynamics parameters
-    const double pathLambda = 0.4;
-    const double pathKappa = 100.0;
-
-    const double agentDrag = 0.15;
-
-    const double agentMinAcceleration = 0.0;
-    const double agentMaxAcceleration = 0.15;
-    const double agentM = 0.5;
-    
     allocateMem();
     initialize();
 
     //---------------------------------------------------------------------------
     // Build connectivity
     //---------------------------------------------------------------------------
-    buildConnectivity(preferredAngleTB1);
+    buildConnectivity(preferredAngleTB1, printConnectivity, connectivityCacheFilename);
 
     initstone_cx();
 
-    cv::namedWindow("Path", CV_WINDOW_NORMAL);
-    cv::resizeWindow("Path", pathImageSize, pathImageSize);
-    cv::Mat pathImage(pathImageSize, pathImageSize, CV_8UC3, cv::Scalar::all(0));
-
-    cv::namedWindow("Activity", CV_WINDOW_NORMAL);
-    cv::resizeWindow("Activity", activityImageWidth, activityImageHeight);
-    cv::moveWindow("Activity", pathImageSize, 0);
-    cv::Mat activityImage(activityImageHeight, activityImageWidth, CV_8UC3, cv::Scalar::all(0));
-
-    // Create Von Mises distribution to sample angular acceleration from
-    std::array<uint32_t, std::mt19937::state_size> seedData;
-    std::random_device seedSource;
-    std::generate(seedData.begin(), seedData.end(),
-                  [&seedSource](){ return seedSource(); });
-    std::seed_seq seeds(std::begin(seedData), std::end(seedData));
-    std::mt19937 gen(seeds);
-
-    VonMisesDistribution<double> pathVonMises(0.0, pathKappa);
-
-    // Create acceleration spline
-    tk::spline accelerationSpline;
-    {
-        // Create vectors to hold the times at which linear acceleration
-        // should change and it's values at those time
-        const unsigned int numAccelerationChanges = numOutwardTimesteps / 50;
-        std::vector<double> accelerationTime(numAccelerationChanges);
-        std::vector<double> accelerationMagnitude(numAccelerationChanges);
-
-        // Draw accelerations from real distribution
-        std::uniform_real_distribution<double> acceleration(agentMinAcceleration,
-                                                            agentMaxAcceleration);
-        std::generate(accelerationMagnitude.begin(), accelerationMagnitude.end(),
-                      [&gen, &acceleration](){ return acceleration(gen); });
+#if defined(FUSED_STEP) || defined(VALIDATE_FUSED_STEP)
+    FusedStep<scalar, Parameters::numColumns> fusedStep(preferredAngleTB1);
+#endif
+
+    // Get pointers to whichever copy of the model state is being simulated
+#ifdef FUSED_STEP
+    const scalar *simRTN2 = fusedStep.getRTN2();
+    const scalar *simRTB1 = fusedStep.getRTB1();
+    const scalar *simRCPU4 = fusedStep.getRCPU4();
+    const scalar *simICPU4 = fusedStep.getICPU4();
+    const scalar *simRPontine = fusedStep.getRPontine();
+    const scalar *simRCPU1 = fusedStep.getRCPU1();
+#else
+    const scalar *simRTN2 = rTN2;
+    const scalar *simRTB1 = rTB1;
+    const scalar *simRCPU4 = rCPU4;
+    const scalar *simICPU4 = iCPU4;
+    const scalar *simRPontine = rPontine;
+    const scalar *simRCPU1 = rCPU1;
+#endif
+
+    // If rendering is required, create renderer and register populations with it
+    std::unique_ptr<ActivityRenderer<scalar>> renderer;
+    if(display || !videoFilename.empty()) {
+        typedef ActivityRenderer<scalar> Renderer;
+        renderer.reset(new Renderer(Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps,
+                                    renderFPS, display, videoFilename));
+        renderer->addPopulation(simRTB1, Parameters::numTB1, "TB1", cv::Point(10, 10),
+                                Renderer::getReds);
+        renderer->addPopulation(simRTN2, Parameters::numTN2, "TN2", cv::Point(300, 110),
+                                Renderer::getBlues, 1);
+        renderer->addPopulation(simRCPU4, Parameters::numCPU4, "CPU4", cv::Point(10, 110),
+                                Renderer::getGreens, 4);
+        renderer->addPopulation(simRPontine, Parameters::numPontine, "Pontine", cv::Point(10, 210),
+                                Renderer::getGreens, 4);
+        renderer->addPopulation(simRCPU1, Parameters::numCPU1, "CPU1", cv::Point(10, 310),
+                                Renderer::getGreens, 4);
+        renderer->start();
+    }
 
-        for(unsigned int i = 0; i < numAccelerationChanges; i++) {
-            accelerationTime[i] = i * 50;
+    // Create lookup table-based encoder to convert heading and velocity to network input
+    const CompassEncoder<scalar> compassEncoder(Parameters::numTB1);
+
+    // If a route bank and route index are specified, replay outbound route from bank
+    std::unique_ptr<RouteBank> routeBank;
+    std::vector<AgentState> generatedRoute;
+    const AgentState *outboundRoute = nullptr;
+    if(positionalArgs.size() >= 2) {
+        routeBank.reset(new RouteBank(positionalArgs[0]));
+        if(routeBank->getNumSteps() != Parameters::numOutwardTimesteps) {
+            std::cerr << "Route bank contains routes of " << routeBank->getNumSteps() << " steps but model requires " << Parameters::numOutwardTimesteps << std::endl;
+            return EXIT_FAILURE;
+        }
+        outboundRoute = routeBank->getRoute(std::strtoull(positionalArgs[1], nullptr, 10));
+    }
+    // Otherwise, generate a random outbound route
+    else {
+        // If no seed is specified, pick one and print it so the run can be reproduced
+        if(!seedSpecified) {
+            std::random_device seedSource;
+            seed = ((uint64_t)seedSource() << 32) | seedSource();
+            std::cout << "Seed: " << seed << std::endl;
         }
 
-        // Build spline from these
-        accelerationSpline.set_points(accelerationTime, accelerationMagnitude);
+        // **NOTE** this generates the same route as route 0 of a route bank generated with this seed
+        Philox4x32 gen(seed, 0);
+        generatedRoute.resize(Parameters::numOutwardTimesteps);
+        generateOutboundRoute(gen, generatedRoute.data());
+        outboundRoute = generatedRoute.data();
     }
 
-#ifdef RECORD_ELECTROPHYS
-    AnalogueCSVRecorder<scalar> tn2Recorder("tn2.csv", rTN2, Parameters::numTN2, "TN2");
-    AnalogueCSVRecorder<scalar> cl1Recorder("cl1.csv", rCL1, Parameters::numCL1, "CL1");
-    AnalogueCSVRecorder<scalar> tb1Recorder("tb1.csv", rTB1, Parameters::numTB1, "TB1");
-    AnalogueCSVRecorder<scalar> cpu4Recorder("cpu4.csv", rCPU4, Parameters::numCPU4, "CPU4");
-    AnalogueCSVRecorder<scalar> cpu1Recorder("cpu1.csv", rCPU1, Parameters::numCPU1, "CPU1");
-#endif  // RECORD_ELECTROPHYS
+    // Register populations which can be recorded - only those enabled on the command line will be
+    // **NOTE** CPU4Memory is the CPU4 integrator state from which the home vector is read
+    ElectrophysRecorder<scalar> recorder(recordSpecification, recordBinary);
+    recorder.addPopulation("TN2", simRTN2, Parameters::numTN2);
+    recorder.addPopulation("TB1", simRTB1, Parameters::numTB1);
+    recorder.addPopulation("CPU4", simRCPU4, Parameters::numCPU4);
+    recorder.addPopulation("CPU4Memory", simICPU4, Parameters::numCPU4);
+    recorder.addPopulation("Pontine", simRPontine, Parameters::numPontine);
+    recorder.addPopulation("CPU1", simRCPU1, Parameters::numCPU1);
+    recorder.checkRequests();
+
+    // Register all state which evolves during simulation with snapshot
+    AgentState agent{0.0, 0.0, 0.0, 0.0, 0.0};
+    Snapshot snapshot;
+    addModelStateToSnapshot(snapshot);
+#if defined(FUSED_STEP) || defined(VALIDATE_FUSED_STEP)
+    snapshot.addVariable(&fusedStep);
+#endif
+    snapshot.addVariable(&agent);
+
+    // If a state saved at the end of the outbound route is specified, load it and start homing
+    unsigned int startTimestep = 0;
+    if(!loadStateFilename.empty()) {
+        snapshot.load(loadStateFilename);
+        snapshot.restore();
+        startTimestep = Parameters::numOutwardTimesteps;
+    }
 
     // Simulate
-    double omega = 0.0;
-    double theta = 0.0;
-    double xVelocity = 0.0;
-    double yVelocity = 0.0;
-    double xPosition = 0.0;
-    double yPosition = 0.0;
-    for(unsigned int i = 0; i < (numOutwardTimesteps + numInwardTimesteps); i++) {
-        // Project velocity onto each TN2 cell's preferred angle and use as speed input
-        for(unsigned int j = 0; j < Parameters::numTN2; j++) {
-            speedTN2[j] = (sin(theta + preferredAngleTN2[j]) * xVelocity) + 
-                (cos(theta + preferredAngleTN2[j]) * yVelocity);
-        }
-
-        // Calculate TB input
-        for(unsigned int j = 0; j < Parameters::numTB1; j++) {
-            const double iTL = cos(preferredAngleTB1[j] - theta);
-            const double iCL = -1.0 / (1.0 + exp(-((6.8 * iTL) - 3.0)));
-            iDirTB1[j] = 1.0 / (1.0 + exp(-((3.0 * iCL) + 0.5)));
-        }
+    for(unsigned int i = startTimestep; i < (Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps); i++) {
+        // Encode heading as TB1 input and project velocity onto each TN2 cell's preferred angle
+        compassEncoder.encode(agent.theta, agent.xVelocity, agent.yVelocity, iDirTB1, speedTN2);
 
         // Step network
+#ifdef FUSED_STEP
+        fusedStep.step(speedTN2, iDirTB1);
+#else
         stepTimeCPU();
+#endif
+
+#ifdef VALIDATE_FUSED_STEP
+        // Step fused model with same input and check it exactly matches GeNN
+        fusedStep.step(speedTN2, iDirTB1);
+        const unsigned int numMismatches = fusedStep.countMismatches(rTN2, rTB1, rCPU4, iCPU4,
+                                                                     rPontine, rCPU1);
+        if(numMismatches != 0) {
+            std::cerr << "Timestep " << i << ": " << numMismatches << " variables differ between fused step and GeNN" << std::endl;
+            return EXIT_FAILURE;
+        }
+#endif  // VALIDATE_FUSED_STEP
 
-#ifdef RECORD_ELECTROPHYS
-        tn2Recorder.record(i);
-        cl1Recorder.record(i);
-        tb1Recorder.record(i);
-        cpu4Recorder.record(i);
-        cpu1Recorder.record(i);
-#endif  // RECORD_ELECTROPHYS
-
-        // Draw compass system activity
-        drawPopulationActivity(rTB1, Parameters::numTB1, "TB1", cv::Point(10, 10),
-                               getReds, activityImage);
-
-        drawPopulationActivity(rTN2, Parameters::numTN2, "TN2", cv::Point(300, 110),
-                               getBlues, activityImage, 1);
-
-        drawPopulationActivity(rCPU4, Parameters::numCPU4, "CPU4", cv::Point(10, 110),
-                               getGreens, activityImage, 4);
-        drawPopulationActivity(rPontine, Parameters::numPontine, "Pontine", cv::Point(10, 210),
-                               getGreens, activityImage, 4);
-        drawPopulationActivity(rCPU1, Parameters::numCPU1, "CPU1", cv::Point(10, 310),
-                               getGreens, activityImage, 4);
+        if(recorder.shouldRecord(i)) {
+            recorder.record(i);
+        }
 
-        // If we are on outbound segment of route
-        const bool outbound = (i < numOutwardTimesteps);
-        double a = 0.0;
+        // If we are on outbound segment of route, read agent state from route
+        const bool outbound = (i < Parameters::numOutwardTimesteps);
         if(outbound) {
-            // Update angular velocity
-            omega = (pathLambda * omega) + pathVonMises(gen);
-
-            // Read linear acceleration off spline
-            a = accelerationSpline((double)i);
+            agent = outboundRoute[i];
         }
-        // Otherwise we're path integrating home
+        // Otherwise we're path integrating home so steer using motor output with fixed acceleration
         else {
-            // Sum left and right motor activity
-            const scalar leftMotor = std::accumulate(&rCPU1[0], &rCPU1[4], 0.0f);
-            const scalar rightMotor = std::accumulate(&rCPU1[4], &rCPU1[8], 0.0f);
-
-            // Use difference between left and right to calculate angular velocity
-            omega = -agentM * (rightMotor - leftMotor);
-
-            // Use fixed acceleration
-            a = 0.1;
+            updateAgent(agent, getHomingAngularVelocity(simRCPU1, Parameters::numCPU1), 0.1);
         }
 
-        // Update heading
-        theta += omega;
-
-        // Update linear velocity
-        // **NOTE** this comes from https://github.com/InsectRobotics/path-integration/blob/master/bee_simulator.py#L77-L83 rather than the methods section
-        xVelocity += sin(theta) * a;
-        yVelocity += cos(theta) * a;
-        xVelocity -= agentDrag * xVelocity;
-        yVelocity -= agentDrag * yVelocity;
-
-        // Update position
-        xPosition += xVelocity;
-        yPosition += yVelocity;
-
-        // Draw agent position (centring so origin is in centre of path image)
-        const cv::Point p((pathImageSize / 2) + (int)xPosition, (pathImageSize / 2) + (int)yPosition);
-        cv::line(pathImage, p, p,
-                 outbound ? CV_RGB(0xFF, 0, 0) : CV_RGB(0, 0xFF, 0));
+        // Pass snapshot of activity and agent position to renderer
+        if(renderer) {
+            renderer->update(agent.xPosition, agent.yPosition, outbound);
+        }
 
-        // Show output image
-        cv::imshow("Path", pathImage);
-        cv::imshow("Activity", activityImage);
-        cv::waitKey(1);
+        // If required, save state at end of outbound route so homing can be re-run from here
+        if(!saveStateFilename.empty() && i == (Parameters::numOutwardTimesteps - 1)) {
+            snapshot.capture();
+            snapshot.save(saveStateFilename);
+        }
     }
+
+#ifdef VALIDATE_FUSED_STEP
+    std::cout << "Fused step matched GeNN bit-for-bit for " << (Parameters::numOutwardTimesteps + Parameters::numInwardTimesteps) << " timesteps" << std::endl;
+#endif  // VALIDATE_FUSED_STEP
     return 0;
 }
\ No newline at end of file
@@ -1,16 +1,22 @@
 #include "simulatorCommon.h"
 
 // Standard C++ includes
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <numeric>
+#include <string>
 
 // Common includes
+#include "../common/connectivity_cache.h"
 #include "../common/connectors.h"
+#include "../common/snapshot.h"
 
 // GeNN generated code includes
 #include "stone_cx_CODE/definitions.h"
 
 // Model includes
+#include "connectivity.h"
 #include "parameters.h"
 
 //---------------------------------------------------------------------------
@@ -32,78 +38,160 @@ void buildTBToCPUConnector(unsigned int numPre, unsigned int numPost,
     for(unsigned int i = 0; i < numPre; i++)
     {
         sparseProjection.indInG[i] = i * 2;
-        sparseProjection.ind[i * 2] = i;
-        sparseProjection.ind[(i * 2) + 1] = i + (numPost / 2);
+        sparseProjection.ind[i * 2] = Connectivity::getTBToCPUTarget(i, Parameters::HemisphereLeft, numPost);
+        sparseProjection.ind[(i * 2) + 1] = Connectivity::getTBToCPUTarget(i, Parameters::HemisphereRight, numPost);
     }
     sparseProjection.indInG[numPre] = numPost;
 }
-}   // Anonymous namespace
 
-void buildConnectivity(const double *preferredAngleTB)
+void buildAllConnectivity(const double *preferredAngleTB)
 {
     // TB1_TB1
     for(unsigned int i = 0; i < Parameters::numTB1; i++) {
         for(unsigned int j = 0; j < Parameters::numTB1; j++) {
-            const double preferredI = preferredAngleTB[i];
-            const double preferredJ = preferredAngleTB[j];
-
-            const double w = (cos(preferredI - preferredJ) - 1.0);
-            gTB1_TB1[(i * Parameters::numTB1) + j] = Parameters::c * w;
+            gTB1_TB1[(i * Parameters::numTB1) + j] = Connectivity::getTB1TB1Weight(preferredAngleTB[i], preferredAngleTB[j],
+                                                                                Parameters::numTB1);
         }
     }
-    std::cout << "TB1->TB1" << std::endl;
-    printDenseMatrix(Parameters::numTB1, Parameters::numTB1, gTB1_TB1);
 
     // CPU4_Pontine
+    // **NOTE** GeNN has no identity matrix type so this is stored as a sparse matrix but
+    // FusedStep (used by the standalone tools and FUSED_STEP builds) indexes rCPU4 directly
     buildOneToOneConnector(Parameters::numCPU4, Parameters::numPontine,
                            CCPU4_Pontine, allocateCPU4_Pontine);
-    std::cout << std::endl << "CPU4->Pontine" << std::endl;
-    printSparseMatrix(Parameters::numCPU4, CCPU4_Pontine);
 
     // TB1_CPU4
     buildTBToCPUConnector(Parameters::numTB1, Parameters::numCPU4,
                           CTB1_CPU4, allocateTB1_CPU4);
-    std::cout << std::endl << "TB1->CPU4" << std::endl;
-    printSparseMatrix(Parameters::numTB1, CTB1_CPU4);
 
     // TB1_CPU1
     buildTBToCPUConnector(Parameters::numTB1, Parameters::numCPU1,
                           CTB1_CPU1, allocateTB1_CPU1);
-    std::cout << std::endl << "TB1->CPU1" << std::endl;
-    printSparseMatrix(Parameters::numTB1, CTB1_CPU1);
 
     // CPU4_CPU1
     allocateCPU4_CPU1(Parameters::numCPU4);
     std::iota(&CCPU4_CPU1.indInG[0], &CCPU4_CPU1.indInG[Parameters::numCPU4 + 1], 0);
-    CCPU4_CPU1.ind[0] = 7;
-    for(unsigned int i = 0; i < 3; i++) {
-        CCPU4_CPU1.ind[1 + i] = 4 + i;
-        CCPU4_CPU1.ind[4 + i] = 1 + i;
+    for(unsigned int i = 0; i < Parameters::numCPU4; i++) {
+        CCPU4_CPU1.ind[i] = Connectivity::getCPU4ToCPU1Target(i, Parameters::numColumns);
     }
-    CCPU4_CPU1.ind[7] = 0;
-    std::cout << std::endl << "CPU4->CPU1" << std::endl;
-    printSparseMatrix(Parameters::numCPU4, CCPU4_CPU1);
 
     // TN2_CPU4
     allocateTN2_CPU4(Parameters::numCPU4);
     CTN2_CPU4.indInG[Parameters::HemisphereLeft] = 0;
-    CTN2_CPU4.indInG[Parameters::HemisphereRight] = 4;
+    CTN2_CPU4.indInG[Parameters::HemisphereRight] = Connectivity::getHemisphereSize(Parameters::numColumns);
     CTN2_CPU4.indInG[Parameters::HemisphereMax] = Parameters::numCPU4;
     std::iota(&CTN2_CPU4.ind[0], &CTN2_CPU4.ind[Parameters::numCPU4], 0);
-    std::cout << std::endl << "TN2->CPU4" << std::endl;
-    printSparseMatrix(Parameters::numTN2, CTN2_CPU4);
 
     // Pontine_CPU1
     allocatePontine_CPU1(Parameters::numPontine);
     std::iota(&CPontine_CPU1.indInG[0], &CPontine_CPU1.indInG[Parameters::numPontine + 1], 0);
-    for(unsigned int i = 0; i < 3; i++) {
-        CPontine_CPU1.ind[i] = 5 + i;
-        CPontine_CPU1.ind[i + 5] = i;
+    for(unsigned int i = 0; i < Parameters::numPontine; i++) {
+        CPontine_CPU1.ind[i] = Connectivity::getPontineToCPU1Target(i, Parameters::numColumns);
+    }
+}
+
+//! Copy sparse projection from cache into arrays allocated with allocateFn
+void loadSparseProjection(const ConnectivityCache &cache, const std::string &name, unsigned int numPre,
+                          SparseProjection &sparseProjection, AllocateFn allocateFn)
+{
+    const unsigned int connN = *cache.getArray<unsigned int>(name + ".connN", 1);
+    allocateFn(connN);
+    std::copy_n(cache.getArray<unsigned int>(name + ".indInG", numPre + 1), numPre + 1, sparseProjection.indInG);
+    std::copy_n(cache.getArray<unsigned int>(name + ".ind", connN), connN, sparseProjection.ind);
+}
+
+void addSparseProjection(ConnectivityCacheWriter &writer, const std::string &name, unsigned int numPre,
+                         const SparseProjection &sparseProjection)
+{
+    writer.addArray(name + ".connN", &sparseProjection.connN, 1);
+    writer.addArray(name + ".indInG", sparseProjection.indInG, numPre + 1);
+    writer.addArray(name + ".ind", sparseProjection.ind, sparseProjection.connN);
+}
+}   // Anonymous namespace
+
+void buildConnectivity(const double *preferredAngleTB, bool print, const std::string &cacheFilename)
+{
+    // Connectivity depends on the number of columns and the TB1 preferred angles
+    // **NOTE** bump version whenever the way connectivity is built changes
+    const uint32_t version = 1;
+    ConnectivityKey key;
+    key.add("stone_cx_mini").add(version).add(Parameters::numColumns).add((uint32_t)sizeof(scalar));
+    for(unsigned int i = 0; i < Parameters::numTB1; i++) {
+        key.add(preferredAngleTB[i]);
+    }
+
+    // If a valid cache exists, copy connectivity from it
+    std::unique_ptr<ConnectivityCache> cache;
+    if(!cacheFilename.empty()) {
+        cache.reset(new ConnectivityCache(cacheFilename, key.getHash()));
     }
-    for(unsigned int i = 0; i < 1; i++) {
-        CPontine_CPU1.ind[i + 3] = 4 + i;
-        CPontine_CPU1.ind[i + 4] = 3 + i;
+    if(cache && cache->isValid()) {
+        std::copy_n(cache->getArray<scalar>("TB1_TB1.g", Parameters::numTB1 * Parameters::numTB1),
+                    Parameters::numTB1 * Parameters::numTB1, gTB1_TB1);
+        loadSparseProjection(*cache, "CPU4_Pontine", Parameters::numCPU4, CCPU4_Pontine, allocateCPU4_Pontine);
+        loadSparseProjection(*cache, "TB1_CPU4", Parameters::numTB1, CTB1_CPU4, allocateTB1_CPU4);
+        loadSparseProjection(*cache, "TB1_CPU1", Parameters::numTB1, CTB1_CPU1, allocateTB1_CPU1);
+        loadSparseProjection(*cache, "CPU4_CPU1", Parameters::numCPU4, CCPU4_CPU1, allocateCPU4_CPU1);
+        loadSparseProjection(*cache, "TN2_CPU4", Parameters::numTN2, CTN2_CPU4, allocateTN2_CPU4);
+        loadSparseProjection(*cache, "Pontine_CPU1", Parameters::numPontine, CPontine_CPU1, allocatePontine_CPU1);
     }
-    std::cout << std::endl << "Pontine->CPU1" << std::endl;
-    printSparseMatrix(Parameters::numPontine, CPontine_CPU1);
+    // Otherwise, build connectivity and, if a cache filename was specified, write it to cache
+    else {
+        buildAllConnectivity(preferredAngleTB);
+
+        if(!cacheFilename.empty()) {
+            ConnectivityCacheWriter writer(cacheFilename, key.getHash());
+            writer.addArray("TB1_TB1.g", gTB1_TB1, Parameters::numTB1 * Parameters::numTB1);
+            addSparseProjection(writer, "CPU4_Pontine", Parameters::numCPU4, CCPU4_Pontine);
+            addSparseProjection(writer, "TB1_CPU4", Parameters::numTB1, CTB1_CPU4);
+            addSparseProjection(writer, "TB1_CPU1", Parameters::numTB1, CTB1_CPU1);
+            addSparseProjection(writer, "CPU4_CPU1", Parameters::numCPU4, CCPU4_CPU1);
+            addSparseProjection(writer, "TN2_CPU4", Parameters::numTN2, CTN2_CPU4);
+            addSparseProjection(writer, "Pontine_CPU1", Parameters::numPontine, CPontine_CPU1);
+            writer.write();
+        }
+    }
+
+    if(print) {
+        std::cout << "TB1->TB1" << std::endl;
+        printDenseMatrix(Parameters::numTB1, Parameters::numTB1, gTB1_TB1);
+        std::cout << std::endl << "CPU4->Pontine" << std::endl;
+        printSparseMatrix(Parameters::numCPU4, CCPU4_Pontine);
+        std::cout << std::endl << "TB1->CPU4" << std::endl;
+        printSparseMatrix(Parameters::numTB1, CTB1_CPU4);
+        std::cout << std::endl << "TB1->CPU1" << std::endl;
+        printSparseMatrix(Parameters::numTB1, CTB1_CPU1);
+        std::cout << std::endl << "CPU4->CPU1" << std::endl;
+        printSparseMatrix(Parameters::numCPU4, CCPU4_CPU1);
+        std::cout << std::endl << "TN2->CPU4" << std::endl;
+        printSparseMatrix(Parameters::numTN2, CTN2_CPU4);
+        std::cout << std::endl << "Pontine->CPU1" << std::endl;
+        printSparseMatrix(Parameters::numPontine, CPontine_CPU1);
+    }
+}
+
+void addModelStateToSnapshot(Snapshot &snapshot)
+{
+    // Simulation time
+    snapshot.addVariable(&t);
+    snapshot.addVariable(&iT);
+
+    // Neuron state
+    snapshot.addVariable(rTN2, Parameters::numTN2);
+    snapshot.addVariable(speedTN2, Parameters::numTN2);
+    snapshot.addVariable(rTB1, Parameters::numTB1);
+    snapshot.addVariable(iDirTB1, Parameters::numTB1);
+    snapshot.addVariable(rCPU4, Parameters::numCPU4);
+    snapshot.addVariable(iCPU4, Parameters::numCPU4);
+    snapshot.addVariable(rPontine, Parameters::numPontine);
+    snapshot.addVariable(rCPU1, Parameters::numCPU1);
+
+    // Postsynaptic input
+    snapshot.addVariable(inSynTB1_TB1, Parameters::numTB1);
+    snapshot.addVariable(inSynCPU4_Pontine, Parameters::numPontine);
+    snapshot.addVariable(inSynTB1_CPU4, Parameters::numCPU4);
+    snapshot.addVariable(inSynTB1_CPU1, Parameters::numCPU1);
+    snapshot.addVariable(inSynCPU4_CPU1, Parameters::numCPU1);
+    snapshot.addVariable(inSynTN2_CPU4, Parameters::numCPU4);
+    snapshot.addVariable(inSynPontine_CPU1, Parameters::numCPU1);
 }
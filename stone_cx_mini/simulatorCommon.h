@@ -1,4 +1,13 @@
 #pragma once
 
+// Standard C++ includes
+#include <string>
+
+// Forward declarations
+class Snapshot;
+
 // Functions
-void buildConnectivity(const double *preferredAngleTB);
\ No newline at end of file
+//! Build connectivity, optionally printing it and copying it from cacheFilename if it
+//! contains a cache built with the same parameters (otherwise it is built and written there)
+void buildConnectivity(const double *preferredAngleTB, bool print = false, const std::string &cacheFilename = "");
+void addModelStateToSnapshot(Snapshot &snapshot);
\ No newline at end of file
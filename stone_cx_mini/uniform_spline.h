@@ -0,0 +1,163 @@
+#pragma once
+
+// Standard C++ includes
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+// Standard C includes
+#include <cmath>
+
+//----------------------------------------------------------------------------
+// UniformSpline
+//----------------------------------------------------------------------------
+//! Natural cubic spline through uniformly spaced knots.
+/*! Produces the same curve (to within rounding) as Tino Kluge's tk::spline, which we previously
+    used, with its default zero curvature boundary conditions. However, because the knots are
+    uniformly spaced, the segment containing x is found with a single multiplication rather
+    than a binary search. The tridiagonal system is solved with
+    the Thomas algorithm and each segment's coefficients are stored contiguously so evaluation
+    touches a single cache line. */
+class UniformSpline
+{
+public:
+    UniformSpline() : m_X0(0.0), m_DX(1.0), m_InvDX(1.0), m_NumKnots(0)
+    {
+    }
+
+    UniformSpline(double x0, double dx, const std::vector<double> &y)
+    {
+        setPoints(x0, dx, y);
+    }
+
+    //----------------------------------------------------------------------------
+    // Public API
+    //----------------------------------------------------------------------------
+    //! Fit spline through y[i] at x = x0 + (i * dx)
+    void setPoints(double x0, double dx, const std::vector<double> &y)
+    {
+        if(y.size() < 3) {
+            throw std::runtime_error("Uniform spline requires at least three knots");
+        }
+        if(dx <= 0.0) {
+            throw std::runtime_error("Uniform spline knot spacing must be positive");
+        }
+
+        m_X0 = x0;
+        m_DX = dx;
+        m_InvDX = 1.0 / dx;
+        m_NumKnots = (unsigned int)y.size();
+
+        const unsigned int n = m_NumKnots;
+
+        // Solve for quadratic coefficients b[] using Thomas algorithm. Interior rows are
+        // (dx / 3) * b[i - 1] + (4 * dx / 3) * b[i] + (dx / 3) * b[i + 1] = rhs[i]
+        // and the natural boundary conditions fix b[0] = b[n - 1] = 0
+        std::vector<double> cPrime(n);
+        std::vector<double> b(n);
+        const double offDiagonal = dx / 3.0;
+        const double diagonal = 4.0 * dx / 3.0;
+        cPrime[0] = 0.0;
+        b[0] = 0.0;
+        for(unsigned int i = 1; i < (n - 1); i++) {
+            const double rhs = ((y[i + 1] - y[i]) / dx) - ((y[i] - y[i - 1]) / dx);
+            const double denominator = diagonal - (offDiagonal * cPrime[i - 1]);
+            cPrime[i] = offDiagonal / denominator;
+            b[i] = (rhs - (offDiagonal * b[i - 1])) / denominator;
+        }
+        b[n - 1] = 0.0;
+        for(unsigned int i = n - 1; i-- > 1;) {
+            b[i] -= cPrime[i] * b[i + 1];
+        }
+
+        // Calculate cubic and linear coefficients and pack into segments
+        m_Segments.resize(n);
+        for(unsigned int i = 0; i < (n - 1); i++) {
+            m_Segments[i].y = y[i];
+            m_Segments[i].a = (1.0 / 3.0) * (b[i + 1] - b[i]) / dx;
+            m_Segments[i].b = b[i];
+            m_Segments[i].c = ((y[i + 1] - y[i]) / dx) - ((1.0 / 3.0) * ((2.0 * b[i]) + b[i + 1]) * dx);
+        }
+
+        // Final 'segment' is used for extrapolation to the right
+        // f_{n-1}(x) = b*(x-x_{n-1})^2 + c*(x-x_{n-1}) + y_{n-1}
+        const Segment &penultimate = m_Segments[n - 2];
+        m_Segments[n - 1].y = y[n - 1];
+        m_Segments[n - 1].a = 0.0;
+        m_Segments[n - 1].b = b[n - 1];
+        m_Segments[n - 1].c = (3.0 * penultimate.a * dx * dx) + (2.0 * penultimate.b * dx) + penultimate.c;
+    }
+
+    double operator()(double x) const
+    {
+        // Extrapolate to the left using first segment's quadratic and linear terms
+        if(x < m_X0) {
+            const Segment &s = m_Segments.front();
+            const double h = x - m_X0;
+            return ((s.b * h) + s.c) * h + s.y;
+        }
+
+        // Find segment, using segment i for x in [x_i, x_i+1) as tk::spline's upper_bound search does
+        const double position = (x - m_X0) * m_InvDX;
+        if(position >= (double)(m_NumKnots - 1)) {
+            const Segment &s = m_Segments.back();
+            const double h = x - getKnot(m_NumKnots - 1);
+            return ((s.b * h) + s.c) * h + s.y;
+        }
+        else {
+            const unsigned int i = (unsigned int)position;
+            const Segment &s = m_Segments[i];
+            const double h = x - getKnot(i);
+            return (((s.a * h) + s.b) * h + s.c) * h + s.y;
+        }
+    }
+
+    //! Evaluate spline at count points x0, x0 + dx, ... e.g. to generate a whole trajectory
+    void evaluate(double x0, double dx, unsigned int count, double *output) const
+    {
+        for(unsigned int i = 0; i < count; i++) {
+            output[i] = (*this)(x0 + ((double)i * dx));
+        }
+    }
+
+    //! Evaluate spline at arbitrary points
+    void evaluate(const double *x, unsigned int count, double *output) const
+    {
+        for(unsigned int i = 0; i < count; i++) {
+            output[i] = (*this)(x[i]);
+        }
+    }
+
+    unsigned int getNumKnots() const{ return m_NumKnots; }
+
+private:
+    //----------------------------------------------------------------------------
+    // Segment
+    //----------------------------------------------------------------------------
+    //! f(x) = a*(x-x_i)^3 + b*(x-x_i)^2 + c*(x-x_i) + y_i
+    struct Segment
+    {
+        double y;
+        double c;
+        double b;
+        double a;
+    };
+
+    //----------------------------------------------------------------------------
+    // Private methods
+    //----------------------------------------------------------------------------
+    double getKnot(unsigned int i) const
+    {
+        return m_X0 + ((double)i * m_DX);
+    }
+
+    //----------------------------------------------------------------------------
+    // Members
+    //----------------------------------------------------------------------------
+    double m_X0;
+    double m_DX;
+    double m_InvDX;
+    unsigned int m_NumKnots;
+
+    std::vector<Segment> m_Segments;
+};